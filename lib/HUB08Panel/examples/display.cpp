@@ -54,6 +54,7 @@ void setup()
     display.drawTextMultilineCentered("HOWIEE\nKIAW ^^");
 
     /// Note: swapBuffers() is called automatically inside drawTextMultilineCentered()
+    /// (wrap several updates in beginFrame()/commitFrame() to swap only once)
     /// The display will now show the text smoothly without flickering
 
     Serial.println("Display initialized and displaying text");
@@ -15,13 +15,14 @@ ISR(TIMER1_COMPA_vect)
 }
 
 HUB08_Panel::HUB08_Panel(uint16_t w, uint16_t h, uint16_t chain)
-    : Adafruit_GFX(w * chain, h)
+    : HUBGlyphGFX(w * chain, h)
 {
     /// Calculate buffer size: 1 bit per pixel
     bufferSize = (w * chain * h) / 8;
     bufferFront = nullptr;
     bufferBack = nullptr;
     brightness = 255;
+    frameDepth = 0;
     initialized = false;
     instance = this; // Set static instance for ISR access
 }
@@ -33,10 +34,16 @@ HUB08_Panel::HUB08_Panel(uint16_t w, uint16_t h, uint16_t chain)
  *   - Timer2 @ 31 kHz PWM on OE pin (D3) for brightness control
  *   - Timer1 @ 10 kHz CTC mode for row scanning ISR
  * @return true if initialization succeeded, false if memory allocation failed
+ *         or the data/clock/latch pins differ from HUB08_PIN_*
  */
 bool HUB08_Panel::begin(const HUB08_Config &cfg)
 {
     config = cfg;
+    // Scan ISR uses the compile-time wiring (HUB08_PIN_*), reject mismatches
+    if (cfg.data_pin_r1 != HUB08_PIN_R1 || cfg.data_pin_r2 != HUB08_PIN_R2 ||
+        cfg.clock_pin != HUB08_PIN_CLK || cfg.latch_pin != HUB08_PIN_LAT)
+        return false;
+
     uint8_t *raw = (uint8_t *)malloc(bufferSize * 2);
     if (!raw)
         return false;
@@ -75,12 +82,27 @@ bool HUB08_Panel::begin(const HUB08_Config &cfg)
     TCCR1B = 0;
     TCNT1 = 0;
 
-    // --- PERBAIKAN DISINI ---
-    // Ganti 1599 (10kHz) menjadi 7999 (2kHz)
     // Rumus: (16.000.000 / Frekuensi) - 1
-    // 10kHz = 1599 (Terlalu berat untuk 2 panel)
-    // 2kHz  = 7999 (Ringan, CPU Load hanya ~40%)
-    OCR1A = 7999;
+    // 10kHz = 1599 (batas atas fast path: R1/R2/CLK satu port, lihat scan())
+    // 2kHz  = 7999 (per-bit path, terlalu berat di 10kHz untuk 2 panel)
+    uint16_t ocr = HUB08_SCAN_OCR1A;
+    if (ocr == 0)
+    {
+        ocr = 7999;
+        if (FAST_SHIFT)
+        {
+            // Periode = 2x perkiraan waktu ISR (shift + ~160 siklus overhead)
+            uint32_t px = (uint32_t)cfg.panel_width * cfg.chain_length;
+            uint32_t busy = px * HUB08_FAST_CYCLES_PER_PX + 160;
+            uint32_t period = busy * 2;
+            if (period < 1600)
+                period = 1600;
+            if (period > 65536)
+                period = 65536;
+            ocr = (uint16_t)(period - 1);
+        }
+    }
+    OCR1A = ocr;
 
     TCCR1B |= (1 << WGM12) | (1 << CS10); // CTC Mode, Prescaler 1
     TIMSK1 |= (1 << OCIE1A);
@@ -116,18 +138,24 @@ bool HUB08_Panel::begin(int8_t r1, int8_t r2, int8_t clk, int8_t lat, int8_t oe,
 
 /**
  * @brief Scan and display a single row
- * Called by Timer1 ISR every 100 µs (10 kHz). Advances through all 16 rows
+ * Called by Timer1 ISR (up to 10 kHz, see begin()). Advances through all 16 rows
  * in sequence, creating a complete refresh cycle.
  *
  * Procedure:
  *   1. Disable output temporarily (OE HIGH to prevent ghosting during shift)
- *   2. Shift 8 bytes (64 pixels) via R1/R2 data pins using direct port access
+ *   2. Shift 8 bytes (64 pixels) via R1/R2 data pins (compile-time pin traits)
+ *      - FAST_SHIFT (R1/R2/CLK on one port): the four port images for each
+ *        (upper bit, lower bit) pair are built once per row, each pixel
+ *        clock is then one table load and exactly two `out` writes
+ *        (data + CLK low, data + CLK high)
+ *      - otherwise: one sbi/cbi per pin
  *   3. Set row address (A-D bits)
  *   4. Pulse latch to load data into row latches
  *   5. Restore OE PWM brightness control
  *   6. Advance to next row (wraps 0→15→0)
  *
- * Performance: ~90 µs per row scan (leaves ~10 µs margin within 100 µs ISR period)
+ * Performance: fast path ~HUB08_FAST_CYCLES_PER_PX (20) cycles per pixel
+ * clock (~80 µs per 64 px row), begin() sizes the scan period to match
  */
 void HUB08_Panel::scan()
 {
@@ -149,85 +177,64 @@ void HUB08_Panel::scan()
     OCR2B = 255;
 #endif
 
-#if defined(__AVR_ATmega2560__)
-    // ===== MEGA 2560 - Custom mapping (D5..D8) =====
-    // Pins may be on different ports (PORTE / PORTH), write each port separately
-
-    for (uint8_t i = 0; i < bytesPerRow; i++)
+    if (FAST_SHIFT)
     {
-        uint8_t ur = upper[i];
-        uint8_t lr = lower ? lower[i] : 0x00;
-
-        for (uint8_t b = 0; b < 8; b++)
+        /// Port images for each (upper, lower) data bit pair, built once
+        /// per row from the port with R1/R2/CLK cleared. Nothing else
+        /// writes this port while the ISR runs, so whole-port writes keep
+        /// the other pins intact.
+        const uint8_t r1 = PinR1::mask;
+        const uint8_t r2 = PinR2::mask;
+        const uint8_t base = DataPort::read() & (uint8_t) ~(r1 | r2 | PinCLK::mask);
+        const uint8_t img[4] = {base, (uint8_t)(base | r1), (uint8_t)(base | r2),
+                                (uint8_t)(base | r1 | r2)};
+
+        for (uint8_t i = 0; i < bytesPerRow; i++)
         {
-            // Set R1
-            if (ur & 0x80)
-                HUB_R1_PORT |= (1 << HUB_R1_BIT);
-            else
-                HUB_R1_PORT &= ~(1 << HUB_R1_BIT);
-
-            // Set R2
-            if (lr & 0x80)
-                HUB_R2_PORT |= (1 << HUB_R2_BIT);
-            else
-                HUB_R2_PORT &= ~(1 << HUB_R2_BIT);
-
-            // Clock Pulse
-            HUB_CLK_PORT |= (1 << HUB_CLK_BIT);  // CLK HIGH
-            HUB_CLK_PORT &= ~(1 << HUB_CLK_BIT); // CLK LOW
-
-            ur <<= 1;
-            lr <<= 1;
+            uint8_t ur = upper[i];
+            uint8_t lr = lower ? lower[i] : 0x00;
+
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                // Index: bit 0 = upper (R1), bit 1 = lower (R2)
+                uint8_t v = img[(ur >> 7) | ((lr >> 6) & 0x02)];
+                DataPort::write(v);                 // Data, CLK low
+                DataPort::write(v | PinCLK::mask);  // CLK rising edge
+
+                ur <<= 1;
+                lr <<= 1;
+            }
         }
+        DataPort::write(base);
     }
-
-    // Latch Pulse
-    HUB_LAT_PORT |= (1 << HUB_LAT_BIT);  // LAT HIGH
-    HUB_LAT_PORT &= ~(1 << HUB_LAT_BIT); // LAT LOW
-
-    // Set Address (PORTF 0-3) - A0-A3
-    uint8_t pf = HUB_ADDR_PORT & 0xF0;
-    pf |= (row & 0x0F);
-    HUB_ADDR_PORT = pf;
-
-#else
-    // ===== UNO / 328P - Custom mapping (D5..D8) =====
-    for (uint8_t i = 0; i < bytesPerRow; i++)
+    else
     {
-        uint8_t ur = upper[i];
-        uint8_t lr = lower ? lower[i] : 0x00;
-        for (uint8_t b = 0; b < 8; b++)
+        // Pins may be on different ports (Mega: PORTE / PORTH), each write
+        // resolves at compile time to the pin's own port register (HUBPins.h)
+        for (uint8_t i = 0; i < bytesPerRow; i++)
         {
-            // R1 (PD5)
-            if (ur & 0x80)
-                HUB_R1_PORT |= (1 << HUB_R1_BIT);
-            else
-                HUB_R1_PORT &= ~(1 << HUB_R1_BIT);
-
-            // R2 (PD6)
-            if (lr & 0x80)
-                HUB_R2_PORT |= (1 << HUB_R2_BIT);
-            else
-                HUB_R2_PORT &= ~(1 << HUB_R2_BIT);
-
-            // Clock pulse (PD7)
-            HUB_CLK_PORT |= (1 << HUB_CLK_BIT);
-            HUB_CLK_PORT &= ~(1 << HUB_CLK_BIT);
-
-            ur <<= 1;
-            lr <<= 1;
+            uint8_t ur = upper[i];
+            uint8_t lr = lower ? lower[i] : 0x00;
+
+            for (uint8_t b = 0; b < 8; b++)
+            {
+                PinR1::write(ur & 0x80); // Set R1
+                PinR2::write(lr & 0x80); // Set R2
+                PinCLK::pulse();         // Clock Pulse
+
+                ur <<= 1;
+                lr <<= 1;
+            }
         }
     }
 
-    // Latch pulse
-    HUB_LAT_PORT |= (1 << HUB_LAT_BIT);
-    HUB_LAT_PORT &= ~(1 << HUB_LAT_BIT);
+    // Latch Pulse
+    PinLAT::pulse();
 
-    // Address (PORTC 0-3)
-    uint8_t pc = HUB_ADDR_PORT & 0xF0;
-    pc |= (row & 0x0F);
-    HUB_ADDR_PORT = pc;
-#endif
+    // Set Address (Mega: PORTF 0-3, Uno: PORTC 0-3) - A0-A3
+    uint8_t pa = HUB_ADDR_PORT & 0xF0;
+    pa |= (row & 0x0F);
+    HUB_ADDR_PORT = pa;
 
     // RESTORE OE
 #if defined(__AVR_ATmega2560__)
@@ -261,6 +268,85 @@ void HUB08_Panel::drawPixel(int16_t x, int16_t y, uint16_t c)
         *ptr &= ~(0x80 >> (x & 7)); // Clear bit (pixel OFF)
 }
 
+/**
+ * @brief Line and rect fills on the back buffer (Adafruit_GFX overrides)
+ * Spans are clipped once, then written as masked edge bytes + memset
+ */
+void HUB08_Panel::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c)
+{
+    fillRect(x, y, w, 1, c);
+}
+
+void HUB08_Panel::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c)
+{
+    fillRect(x, y, 1, h, c);
+}
+
+void HUB08_Panel::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c)
+{
+    if (!initialized)
+        return;
+
+    uint16_t bytesPerRow = (config.panel_width * config.chain_length) / 8;
+    HUBRaster::fillRect(bufferBack, bytesPerRow, width(), height(), x, y, w, h,
+                        c != 0);
+}
+
+/**
+ * @brief Bitmaps on the back buffer, one byte operation per 8 pixels
+ * PROGMEM for const bitmaps, RAM otherwise (same split as Adafruit_GFX)
+ */
+void HUB08_Panel::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                             int16_t w, int16_t h, uint16_t c)
+{
+    if (!initialized)
+        return;
+    HUBRaster::blitBitmap(bufferBack, width() / 8, width(), height(), bitmap,
+                          true, x, y, w, h, c != 0, false, false);
+}
+
+void HUB08_Panel::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                             int16_t w, int16_t h, uint16_t c, uint16_t bg)
+{
+    if (!initialized)
+        return;
+    HUBRaster::blitBitmap(bufferBack, width() / 8, width(), height(), bitmap,
+                          true, x, y, w, h, c != 0, bg != 0, true);
+}
+
+void HUB08_Panel::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                             int16_t w, int16_t h, uint16_t c)
+{
+    if (!initialized)
+        return;
+    HUBRaster::blitBitmap(bufferBack, width() / 8, width(), height(), bitmap,
+                          false, x, y, w, h, c != 0, false, false);
+}
+
+void HUB08_Panel::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                             int16_t w, int16_t h, uint16_t c, uint16_t bg)
+{
+    if (!initialized)
+        return;
+    HUBRaster::blitBitmap(bufferBack, width() / 8, width(), height(), bitmap,
+                          false, x, y, w, h, c != 0, bg != 0, true);
+}
+
+/**
+ * @brief Draw a GFXfont glyph into back buffer, 8 pixels per byte operation
+ * HUBGlyphGFX override - rows and columns are clipped against bounds
+ */
+void HUB08_Panel::drawGlyph(const uint8_t *bits, uint8_t w, uint8_t h,
+                            int16_t x, int16_t y, uint16_t c)
+{
+    if (!initialized)
+        return;
+
+    uint16_t bytesPerRow = (config.panel_width * config.chain_length) / 8;
+    blitGlyph(bufferBack, bytesPerRow, width(), height(), bits, w, h, x, y,
+              c != 0);
+}
+
 /**
  * @brief Fill entire back buffer with solid color
  * Adafruit_GFX override
@@ -309,6 +395,39 @@ void HUB08_Panel::swapBuffers(bool copyFrontToBack)
     }
 }
 
+/**
+ * @brief Open a frame transaction (see commitFrame())
+ */
+void HUB08_Panel::beginFrame()
+{
+    if (frameDepth < 255)
+        frameDepth++;
+}
+
+/**
+ * @brief Close a frame transaction; the outermost one swaps once
+ *
+ * @param copyFrontToBack Passed to swapBuffers()
+ * @details Brightness set during the transaction is applied right after
+ *          the swap, so it changes together with the new frame.
+ */
+void HUB08_Panel::commitFrame(bool copyFrontToBack)
+{
+    bool txn = frameDepth != 0;
+    if (txn && --frameDepth)
+        return; /// Still inside an outer transaction
+
+    swapBuffers(copyFrontToBack);
+    if (txn)
+        setBrightness(brightness);
+}
+
+void HUB08_Panel::autoCommit()
+{
+    if (!frameDepth)
+        swapBuffers(true);
+}
+
 /**
  * @brief Set display brightness via hardware PWM
  * Controls brightness using appropriate timer for the MCU:
@@ -324,7 +443,8 @@ void HUB08_Panel::swapBuffers(bool copyFrontToBack)
 void HUB08_Panel::setBrightness(uint8_t b)
 {
     brightness = b;
-    if (!initialized)
+    /// Inside a frame transaction: applied by commitFrame() with the frame
+    if (!initialized || frameDepth)
         return;
 
     /// Look up gamma-corrected PWM value from PROGMEM table
@@ -352,14 +472,11 @@ int16_t HUB08_Panel::getTextWidth(const String &text)
 
 /**
  * @brief Get the pixel height of current font
+ * Cached until the font or text size changes (HUBGlyphGFX::lineHeight)
  */
 int16_t HUB08_Panel::getTextHeight()
 {
-    int16_t x1, y1;
-    uint16_t w, h;
-
-    getTextBounds("Ay", 0, 0, &x1, &y1, &w, &h);
-    return h;
+    return lineHeight();
 }
 
 /**
@@ -368,69 +485,29 @@ int16_t HUB08_Panel::getTextHeight()
  * @param text Text string with optional \\n for line breaks
  * @details
  *   - Clears back buffer
- *   - Parses \\n characters to split lines
+ *   - Splits on \\n characters (empty lines are skipped)
  *   - Centers each line horizontally and vertically on display
  *   - Swaps buffers to display
- *   - Max 8 lines supported
+ *   - Max 8 lines supported, extra lines are ignored
  *   - Works on all supported resolutions (64×32, 128×32, etc)
+ *   - Lines are laid out in place (HUBGlyphGFX::drawLinesCentered), no
+ *     String copies or heap allocation
  */
-void HUB08_Panel::drawTextMultilineCentered(const String &text)
+void HUB08_Panel::drawTextMultilineCentered(const char *text)
 {
     clearScreen();
 
-    /// ---- 1) Split text by newline characters ----
-    const uint8_t MAX_LINES = 8;
-    String lines[MAX_LINES];
-    uint8_t lineCount = 0;
-
-    String current = "";
-    for (uint16_t i = 0; i <= text.length(); i++)
-    {
-        char c = text[i];
-
-        if (c == '\n' || c == '\0')
-        {
-            if (current.length() > 0)
-                lines[lineCount++] = current;
-            current = "";
-        }
-        else
-        {
-            current += c;
-        }
-    }
-
-    if (lineCount == 0)
+    /// Font height at least 8, tighter line spacing (pitch = height - 2),
+    /// baseline at line top + font height
+    const HUBTextLayout layout = {8, 8, -2, false, false};
+    if (!drawLinesCentered(text, layout))
         return;
 
-    /// ---- 2) Get text metrics ----
-    int16_t fontHeight = getTextHeight();
-    if (fontHeight < 8)
-        fontHeight = 8; // Safety minimum
-
-    /// Tighter line spacing for multiline text
-    int16_t lineSpacing = fontHeight - 2;
-    int16_t totalHeight = (lineCount - 1) * lineSpacing + fontHeight;
-
-    /// ---- 3) Calculate vertical center ----
-    /// True center: (displayHeight - textTotalHeight) / 2
-    int16_t verticalMargin = (height() - totalHeight) / 2;
-
-    /// For Adafruit fonts, setCursor uses the baseline + descent
-    /// We need to account for this to truly center
-    int16_t baselineY = verticalMargin + fontHeight;
-
-    /// ---- 4) Draw and center-align each line ----
-    for (uint8_t i = 0; i < lineCount; i++)
-    {
-        int16_t lineWidth = getTextWidth(lines[i]);
-        int16_t centerX = (width() - lineWidth) / 2;
-        int16_t lineY = baselineY + i * lineSpacing;
-
-        setCursor(centerX, lineY);
-        print(lines[i]);
-    }
+    /// Swap buffers to display (deferred to commitFrame() in a transaction)
+    autoCommit();
+}
 
-    /// ---- 5) Swap buffers to display ----
-    swapBuffers(true);
+void HUB08_Panel::drawTextMultilineCentered(const String &text)
+{
+    drawTextMultilineCentered(text.c_str());
 }
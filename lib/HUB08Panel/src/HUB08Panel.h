@@ -4,6 +4,9 @@
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include <avr/pgmspace.h>
+#include "HUBGlyph.h"
+#include "HUBPins.h"
+#include "HUBRaster.h"
 
 /**
  * @file HUB08Panel.h
@@ -28,41 +31,52 @@
  * @see README.md for MCU compatibility table and supported boards list
  */
 
-/// ========== MCU Auto-Detection & Port Mapping ==========
+/// ========== MCU Auto-Detection & Pin Mapping ==========
 /// This library ONLY supports specific Arduino boards with compatible hardware.
 /// See README.md for full compatibility table.
+///
+/// Data/clock/latch pins are plain Arduino pin numbers, resolved at compile
+/// time to port + bit by HUBPins.h (single sbi/cbi where the port allows it).
+/// Override from platformio.ini, e.g. `build_flags = -DHUB08_PIN_R1=9`.
+/// Pins passed to begin() must match these values.
+
+#ifndef HUB08_PIN_R1
+#define HUB08_PIN_R1 5 ///< Upper half data (Mega: PE3, Uno: PD5)
+#endif
+#ifndef HUB08_PIN_R2
+#define HUB08_PIN_R2 6 ///< Lower half data (Mega: PH3, Uno: PD6)
+#endif
+#ifndef HUB08_PIN_CLK
+#define HUB08_PIN_CLK 7 ///< Shift clock (Mega: PH4, Uno: PD7)
+#endif
+#ifndef HUB08_PIN_LAT
+#define HUB08_PIN_LAT 8 ///< Latch (Mega: PH5, Uno: PB0)
+#endif
 
-#if defined(__AVR_ATmega2560__)
-// ========== Arduino Mega 2560 - USER MAPPING: D5..D8 ==========
-// User requested mapping for Mega using digital pins 5..8.
-// On Mega2560:
-//   D5 -> PORTE bit 3  (PE3)  - R1
-//   D6 -> PORTH bit 3  (PH3)  - R2
-//   D7 -> PORTH bit 4  (PH4)  - CLK
-//   D8 -> PORTH bit 5  (PH5)  - LAT
-
-#define HUB_R1_PORT PORTE
-#define HUB_R1_DDR DDRE
-#define HUB_R1_BIT 3 // PE3 (D5)
-
-#define HUB_R2_PORT PORTH
-#define HUB_R2_DDR DDRH
-#define HUB_R2_BIT 3 // PH3 (D6)
-
-#define HUB_CLK_PORT PORTH
-#define HUB_CLK_DDR DDRH
-#define HUB_CLK_BIT 4 // PH4 (D7)
-
-#define HUB_LAT_PORT PORTH
-#define HUB_LAT_DDR DDRH
-#define HUB_LAT_BIT 5 // PH5 (D8)
+/// Timer1 compare value for the row scan ISR (prescaler 1). 0 (default)
+/// derives it in begin() from the chain width:
+/// - R1/R2/CLK on one port (FAST_SHIFT, Uno default PD5/PD6/PD7): twice the
+///   estimated row shift time, so the ISR stays under ~50% CPU, floored at
+///   10 kHz (1599). 10 kHz holds up to 32 px per row; one 64 px panel runs
+///   at ~5.5 kHz, two chained at ~3 kHz.
+/// - otherwise the per-bit path keeps 2 kHz (7999).
+/// A non-zero value forces a fixed rate.
+#ifndef HUB08_SCAN_OCR1A
+#define HUB08_SCAN_OCR1A 0
+#endif
 
-// OE / PWM output: D3 -> PORTE bit 5 (OC3C / Timer3 on Mega)
-#define HUB_OE_PORT PORTE
-#define HUB_OE_DDR DDRE
-#define HUB_OE_BIT 5 // PE5 (D3)
+/// Estimated CPU cycles per pixel clock on the FAST_SHIFT path (table
+/// index + load, two `out`, two shifts, loop), counted by hand and not
+/// measured on hardware. Used only to derive the scan rate above; raise it
+/// if the main loop starves on long chains.
+#ifndef HUB08_FAST_CYCLES_PER_PX
+#define HUB08_FAST_CYCLES_PER_PX 20
+#endif
 
-// Address lines remain PORTF (A0-A3)
+#if defined(__AVR_ATmega2560__)
+// ========== Arduino Mega 2560 ==========
+// OE / PWM output: D3 -> PORTE bit 5 (OC3C / Timer3 on Mega)
+// Address lines remain PORTF (A0-A3), written as one nibble
 #define HUB_ADDR_PORT PORTF
 #define HUB_ADDR_DDR DDRF
 
@@ -70,33 +84,7 @@
 
 #elif defined(__AVR_ATmega328P__)
 // ========== Arduino Uno / Nano / Pro Mini (ATmega328P) ==========
-// Map pins 5..8 to data/clock/latch for Uno-family as requested:
-//   D5 -> PD5  - R1
-//   D6 -> PD6  - R2
-//   D7 -> PD7  - CLK
-//   D8 -> PB0  - LAT
 // OE remains D3 (PD3) for Timer2 PWM, address lines on PORTC (A0-A3)
-
-#define HUB_R1_PORT PORTD
-#define HUB_R1_DDR DDRD
-#define HUB_R1_BIT 5 // PD5 (D5)
-
-#define HUB_R2_PORT PORTD
-#define HUB_R2_DDR DDRD
-#define HUB_R2_BIT 6 // PD6 (D6)
-
-#define HUB_CLK_PORT PORTD
-#define HUB_CLK_DDR DDRD
-#define HUB_CLK_BIT 7 // PD7 (D7)
-
-#define HUB_LAT_PORT PORTB
-#define HUB_LAT_DDR DDRB
-#define HUB_LAT_BIT 0 // PB0 (D8)
-
-#define HUB_OE_PORT PORTD
-#define HUB_OE_DDR DDRD
-#define HUB_OE_BIT 3 // PD3 (D3)
-
 #define HUB_ADDR_PORT PORTC
 #define HUB_ADDR_DDR DDRC
 
@@ -165,16 +153,30 @@ struct HUB08_Config
  *   - Timer2: 31 kHz PWM on OE pin for brightness control
  *   - Double buffer: Back buffer for drawing, front buffer for display
  *   - Adafruit_GFX compatible: Full drawing API + custom fonts
+ *     (GFXfont text is blitted a byte at a time, see HUBGlyph.h)
  *
  * @note OE pin MUST be D3 (OC2B) for Timer2 PWM to function
  */
-class HUB08_Panel : public Adafruit_GFX
+class HUB08_Panel : public HUBGlyphGFX
 {
 public:
   /// Static instance pointer for ISR access
   static HUB08_Panel *instance;
 
 private:
+  typedef HUBPin<HUB08_PIN_R1> PinR1;
+  typedef HUBPin<HUB08_PIN_R2> PinR2;
+  typedef HUBPin<HUB08_PIN_CLK> PinCLK;
+  typedef HUBPin<HUB08_PIN_LAT> PinLAT;
+  typedef PinR1::Port DataPort;
+
+public:
+  /// True when R1, R2 and CLK live on one port (single-write shift loop)
+  static const bool FAST_SHIFT = HUBSamePort<PinR1, PinR2>::value &&
+                                 HUBSamePort<PinR1, PinCLK>::value;
+
+private:
+
   HUB08_Config config;
 
   uint8_t *bufferFront; ///< Front buffer (displayed by ISR)
@@ -183,6 +185,10 @@ private:
 
   volatile bool initialized; ///< Initialization flag (ISR-aware)
   uint8_t brightness;        ///< Current brightness 0-255
+  uint8_t frameDepth;        ///< Open beginFrame() calls (0 = none)
+
+  /// End of a drawing helper: swap unless inside beginFrame()
+  void autoCommit();
 
 public:
   /**
@@ -195,7 +201,8 @@ public:
   /**
    * @brief Initialize with HUB08_Config structure
    * @param cfg Configuration struct with pin mappings
-   * @return true if successful, false if memory allocation failed
+   * @return true if successful, false if memory allocation failed or the
+   *         data/clock/latch pins differ from HUB08_PIN_*
    */
   bool begin(const HUB08_Config &cfg);
   /**
@@ -235,12 +242,13 @@ public:
 
   /**
    * @brief Draw multiline centered text with newline support
-   * @param text Text with optional \\n for line breaks
+   * @param text Text with optional \\n for line breaks (max 8 lines)
    */
   void drawTextMultilineCentered(const String &text);
+  void drawTextMultilineCentered(const char *text);
 
   /**
-   * @brief Scan single row (called by Timer1 ISR @ 10 kHz)
+   * @brief Scan single row (called by Timer1 ISR, see HUB08_SCAN_OCR1A)
    * @note User should NOT call this directly; ISR manages it
    */
   void scan();
@@ -264,6 +272,36 @@ public:
    */
   void clearScreen();
 
+  /**
+   * @brief Horizontal line via masked byte writes (Adafruit_GFX override)
+   */
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c) override;
+
+  /**
+   * @brief Vertical line, one masked byte per row (Adafruit_GFX override)
+   */
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c) override;
+
+  /**
+   * @brief Filled rect: masked edge bytes + memset per row (Adafruit_GFX override)
+   */
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t c) override;
+
+  /**
+   * @brief 1bpp bitmap blitted a byte at a time (hides Adafruit_GFX versions)
+   * @details `const` bitmaps are read from PROGMEM, non-const from RAM, as
+   *          in Adafruit_GFX. With `bg`, clear bits are drawn in bg.
+   */
+  using Adafruit_GFX::drawBitmap;
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                  int16_t w, int16_t h, uint16_t c);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                  int16_t w, int16_t h, uint16_t c, uint16_t bg);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                  int16_t w, int16_t h, uint16_t c);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap,
+                  int16_t w, int16_t h, uint16_t c, uint16_t bg);
+
   /**
    * @brief Atomically swap front and back buffers
    * @param copyFrontToBack If true, copy display buffer to drawing buffer after swap
@@ -271,6 +309,26 @@ public:
    */
   void swapBuffers(bool copyFrontToBack = false);
 
+  /**
+   * @brief Open a frame transaction
+   * @details Until the matching commitFrame(), drawing helpers
+   *          (drawTextMultilineCentered) do not swap on their own and
+   *          setBrightness() is deferred, so one logical update (clear,
+   *          text, brightness) costs a single swap. Transactions nest;
+   *          only the outermost commitFrame() publishes.
+   */
+  void beginFrame();
+
+  /**
+   * @brief Close a frame transaction and publish the back buffer
+   * @param copyFrontToBack Same as swapBuffers()
+   * @note Outside a transaction this is simply swapBuffers(copyFrontToBack)
+   */
+  void commitFrame(bool copyFrontToBack = true);
+
+  /// True between beginFrame() and its matching commitFrame()
+  bool inFrame() const { return frameDepth != 0; }
+
   /**
    * @brief Set display brightness via hardware PWM
    * @param b Brightness value (0-255, 0=off, 255=maximum)
@@ -278,6 +336,19 @@ public:
    * @details Controls Timer2 OCR2B register (OE pin PWM duty cycle)
    */
   void setBrightness(uint8_t b);
+
+protected:
+  /**
+   * @brief OR/clear a GFXfont glyph into the back buffer (HUBGlyphGFX hook)
+   * @param bits Glyph bitmap bit stream in PROGMEM
+   * @param w Glyph width in pixels
+   * @param h Glyph height in pixels
+   * @param x Left edge of the glyph box
+   * @param y Top edge of the glyph box
+   * @param c Color (1 = ON, 0 = OFF)
+   */
+  void drawGlyph(const uint8_t *bits, uint8_t w, uint8_t h,
+                 int16_t x, int16_t y, uint16_t c) override;
 };
 
 #endif
@@ -2,6 +2,10 @@
 
 HUB12_Panel *HUB12_Panel::instance = nullptr;
 
+const uint16_t HUB12_Panel::rowBits[16] PROGMEM = {
+    0x0001, 0x0002, 0x0004, 0x0008, 0x0010, 0x0020, 0x0040, 0x0080,
+    0x0100, 0x0200, 0x0400, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000};
+
 const uint8_t dim_curve[] PROGMEM = {
     0,   1,   1,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,   3,   3,
     3,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   4,   4,
@@ -22,36 +26,172 @@ const uint8_t dim_curve[] PROGMEM = {
     193, 196, 200, 203, 207, 211, 214, 218, 222, 226, 230, 234, 238, 242, 247,
     252};
 
-ISR(TIMER1_COMPA_vect) {
+// Weak: HUB12_FIXED_ISR() di sketch menggantinya dengan ISR yang langsung
+// memanggil scan() HUB12_FixedPanel (geometri compile-time)
+ISR(TIMER1_COMPA_vect, __attribute__((weak))) {
   if (HUB12_Panel::instance)
     HUB12_Panel::instance->scan();
 }
 
 HUB12_Panel::HUB12_Panel(uint16_t w, uint16_t h, uint16_t chain)
-    : Adafruit_GFX(w * chain, h) {
+    : HUBGlyphGFX(w * chain, h) {
   config.width = w;
   config.height = h;
   config.chain = chain;
   bufferSize = (w * chain * h) / 8;
+  frameSize = bufferSize;
+  // Paralel: tiap line shift sub-chain sendiri, LINE_BITS bit per clock
+  wireRowBytes = (w * chain / 8 / DATA_LINES) * 4 * LINE_BITS;
+  wireSize = wireRowBytes * 4;
+  planes = 1;
   bufferFront = nullptr;
   bufferBack = nullptr;
+  wire[0] = wire[1] = wire[2] = nullptr;
+  wireFront = nullptr;
+  wireShown = 0;
+  wireReady = 0;
+  wireCount = 2;
+  scanRow = 0;
+  scanPlane = 0;
+  scanOffset = 0;
+  scanTicks = 1600;
+  sliceMaxBytes = 0;
+  sliceBytes = wireRowBytes;
+  lastSliceBytes = wireRowBytes;
+  scanSlices = 1;
+  scanSlice = 0;
+  backend = HUB12_BITBANG;
+  dirtyRows = 0;
+  frameCount = 0;
+  frameDepth = 0;
+  scrollStrip = nullptr;
+  stripNext = nullptr;
+  stripShown = nullptr;
+  stripStride = 0;
+  stripPeriod = 0;
+  stripOffset = 0;
+  stripPos = 0;
+  scrollX = 0;
+  scrollW = 0;
+  scrollX1 = 0;
+  scrollY = 0;
+  scrollFont = nullptr;
+  scrollSizeX = scrollSizeY = 1;
+  scrollSeamless = false;
+  scrollGap = 16;
+  tickerRing = nullptr;
+  tickerHead = 0;
+  tickerCount = 0;
+  tickerX = 0;
+  tickerTail = 0;
+  tickerColor = 0;
+  tickerFull = true;
+  for (uint8_t i = 0; i < HUB12_MAX_ZONES; i++)
+    zones[i] = nullptr;
+  zonesCleared = false;
+  transEffect = HUB12_TRANSITION_NONE;
+  transDuration = 0;
+  transStart = 0;
+  transPos = 0;
+  transTotal = 0;
+  transLfsr = 1;
+  transTaps = 0;
+  scrollRate = 25 << 8;
+  scrollPos = 0;
+  scrollRem = 0;
+  scrollShown = 0;
+  scrollDropped = 0;
+  scrollLead = 0;
+  lastScrollTime = 0;
+  isScrolling = false;
+  initialized = false;
   instance = this;
 }
 
 bool HUB12_Panel::begin(int8_t r, int8_t clk, int8_t lat, int8_t oe, int8_t a,
                         int8_t b, uint16_t w, uint16_t h, uint16_t chain) {
   config = {r, clk, lat, oe, a, b, w, h, chain};
-  // Allocate double buffer (front + back)
-  uint8_t *raw = (uint8_t *)malloc(bufferSize * 2);
+  // Scan ISR memakai wiring compile-time (HUB12_PIN_*), tolak jika beda
+  if (lat != HUB12_PIN_LAT || a != HUB12_PIN_A || b != HUB12_PIN_B)
+    return false;
+#if HUB12_HAS_MSPIM
+  if (backend == HUB12_MSPIM) {
+    // Data keluar di TXDn, clock di XCKn (tidak punya nomor pin Arduino,
+    // harus disambung manual: lihat HUB12_MSPIM_XCK_WIRED)
+    if (!HUB12_MSPIM_XCK_WIRED || r != Mspim::txdPin)
+      return false;
+  } else
+#endif
+  if (r != HUB12_PIN_R || clk != HUB12_PIN_CLK)
+    return false;
+  // Chain dibagi rata ke semua data line
+  if (chain % DATA_LINES)
+    return false;
+
+  // Allocate double buffer (front + back) plus 2-3 wire buffers for the ISR
+  // Tiap buffer berisi semua bit plane (frameSize = bufferSize * planes)
+  wireSize = wireRowBytes * 4 * planes;
+  uint8_t *raw = (uint8_t *)malloc(frameSize * 2 + wireSize * wireCount);
   if (!raw)
     return false;
   bufferFront = raw;
-  bufferBack = raw + bufferSize;
-  memset(bufferFront, 0, bufferSize); // Clear (Black)
-  memset(bufferBack, 0, bufferSize);
+  bufferBack = raw + frameSize;
+  memset(bufferFront, 0, frameSize); // Clear (Black)
+  memset(bufferBack, 0, frameSize);
+  for (uint8_t i = 0; i < wireCount; i++) {
+    wire[i] = raw + frameSize * 2 + wireSize * i;
+    buildWireBuffer(wire[i], bufferFront, 0xFFFF);
+    wireStale[i] = 0;
+  }
+  wireShown = 0;
+  wireReady = 0;
+  wireFront = wire[0];
+  dirtyRows = 0;
 
-  pinMode(r, OUTPUT);
-  pinMode(clk, OUTPUT);
+  // Periode tick: ~625Hz per baris (mono) atau plane 0 (BCM)
+  scanTicks = 1600;
+  if (planes > 1) {
+#ifdef HUB12_BCM_BASE_TICKS
+    scanTicks = HUB12_BCM_BASE_TICKS;
+#else
+    // Frame = 4 baris x (2^planes - 1) x BASE tick, 2 MHz tick Timer1
+    scanTicks = 2000000UL / (4UL * HUB12_BCM_REFRESH_HZ * ((1 << planes) - 1));
+    // Plane terkecil minimal selama shift satu baris
+    uint16_t shiftTicks = wireRowBytes * HUB12_SHIFT_TICKS_PER_BYTE;
+    if (scanTicks < shiftTicks)
+      scanTicks = shiftTicks;
+#endif
+  }
+  scanSlices = 1;
+  sliceBytes = lastSliceBytes = wireRowBytes;
+  if (sliceMaxBytes && sliceMaxBytes < wireRowBytes) {
+    // Bagi rata: slice = ceil(rowBytes / max), byte per slice = ceil juga
+    uint16_t slices = (wireRowBytes + sliceMaxBytes - 1) / sliceMaxBytes;
+    if (slices > 255)
+      slices = 255;
+    sliceBytes = (wireRowBytes + slices - 1) / slices;
+    slices = (wireRowBytes + sliceBytes - 1) / sliceBytes;
+    lastSliceBytes = wireRowBytes - sliceBytes * (slices - 1);
+    scanSlices = slices;
+    // Refresh per baris tetap, kecuali slice terlalu pendek untuk shift
+    uint16_t minTicks = sliceBytes * (2 * HUB12_SHIFT_TICKS_PER_BYTE);
+    scanTicks /= slices;
+    if (scanTicks < minTicks)
+      scanTicks = minTicks;
+  }
+  scanSlice = 0;
+  scanOffset = 0;
+
+#if HUB12_HAS_MSPIM
+  if (backend == HUB12_MSPIM) {
+    Mspim::begin();
+  } else
+#endif
+  {
+    pinMode(r, OUTPUT);
+    PinR::Port::output(DATA_MASK); // Data line tambahan (paralel)
+    pinMode(clk, OUTPUT);
+  }
   pinMode(lat, OUTPUT);
   pinMode(oe, OUTPUT);
   pinMode(a, OUTPUT);
@@ -67,7 +207,8 @@ bool HUB12_Panel::begin(int8_t r, int8_t clk, int8_t lat, int8_t oe, int8_t a,
   TCCR1A = 0;
   TCCR1B = 0;
   TCNT1 = 0;
-  OCR1A = 1600; // ~625Hz ISR for stable, proven refresh
+  // ~625Hz ISR for stable, proven refresh (BCM: scan() atur per plane)
+  OCR1A = scanTicks;
   TCCR1B |= (1 << WGM12) | (1 << CS11);
   TIMSK1 |= (1 << OCIE1A);
   sei();
@@ -76,86 +217,47 @@ bool HUB12_Panel::begin(int8_t r, int8_t clk, int8_t lat, int8_t oe, int8_t a,
   return true;
 }
 
-void HUB12_Panel::scan() {
-  if (!initialized)
-    return;
-  static uint8_t scanRow = 0;
+void HUB12_Panel::scan() { scanWith<0>(); }
 
-// 1. Turn off Output (Blanking)
-#if defined(__AVR_ATmega2560__)
-  uint8_t currentPWM = OCR3C;
-  OCR3C = OE_ACTIVE_LOW ? 255 : 0;
-#endif
+bool HUB12_Panel::setScanSliceBytes(uint16_t maxBytes) {
+  // Ukuran slice dihitung saat begin()
+  if (initialized)
+    return false;
+  sliceMaxBytes = maxBytes;
+  return true;
+}
 
-  // 2. Shift Data for 4 rows simultaneously (BEFORE setting address!)
-  // HUB12: width(32*chain) pixels per row = 4 bytes
-  int bytesPerPanel = 4;
-  int totalWidthBytes = config.chain * bytesPerPanel;
-
-  // Helper ShiftOut (MSB First)
-  auto shiftOutByte = [&](uint8_t val) {
-    for (int k = 0; k < 8; k++) {
-      // R (Pin 5 - PE3)
-      if (val & 0x80)
-        PORTE |= (1 << 3);
-      else
-        PORTE &= ~(1 << 3);
-      // CLK (Pin 7 - PH4)
-      PORTH |= (1 << 4);
-      PORTH &= ~(1 << 4);
-      val <<= 1;
-    }
-  };
-
-  for (int i = 0; i < totalWidthBytes; i++) {
-    uint8_t row0 = scanRow;
-    uint8_t row1 = scanRow + 4;
-    uint8_t row2 = scanRow + 8;
-    uint8_t row3 = scanRow + 12;
-
-    uint8_t b0 = (row0 < config.height)
-                     ? ~bufferFront[i + (row0 * totalWidthBytes)]
-                     : 0xFF;
-    uint8_t b1 = (row1 < config.height)
-                     ? ~bufferFront[i + (row1 * totalWidthBytes)]
-                     : 0xFF;
-    uint8_t b2 = (row2 < config.height)
-                     ? ~bufferFront[i + (row2 * totalWidthBytes)]
-                     : 0xFF;
-    uint8_t b3 = (row3 < config.height)
-                     ? ~bufferFront[i + (row3 * totalWidthBytes)]
-                     : 0xFF;
-
-    // Standard DMD order: 12 -> 8 -> 4 -> 0 (b3, b2, b1, b0)
-    shiftOutByte(b3);
-    shiftOutByte(b2);
-    shiftOutByte(b1);
-    shiftOutByte(b0);
-  }
-
-  // 3. Latch (load shifted data into output latches)
-  PORTH |= (1 << 5);
-  PORTH &= ~(1 << 5);
-
-  // 4. Select Row AFTER latch (prevents ghosting!)
-  // Old data was already latched, now safe to change address
-  uint8_t portF = PORTF;
-  portF &= 0xFC;
-  portF |= (scanRow & 0x03);
-  PORTF = portF;
-
-// 5. Restore Brightness
-#if defined(__AVR_ATmega2560__)
-  OCR3C = currentPWM;
-#endif
+bool HUB12_Panel::setScanBackend(HUB12_Backend b) {
+  if (initialized)
+    return false;
+  // MSPIM hanya punya satu jalur data (TXDn)
+  if (b == HUB12_MSPIM && (!HUB12_HAS_MSPIM || DATA_LINES > 1))
+    return false;
+  backend = b;
+  return true;
+}
 
-  // Advance to next scan row (0->1->2->3->0)
-  scanRow = (scanRow + 1) & 0x03;
+bool HUB12_Panel::setTripleBuffering(bool enable) {
+  // Jumlah wire buffer ditentukan saat begin()
+  if (initialized)
+    return false;
+  wireCount = enable ? 3 : 2;
+  return true;
+}
+
+bool HUB12_Panel::setColorDepth(uint8_t bits) {
+  // Ukuran buffer ditentukan saat begin(), tidak bisa diubah sesudahnya
+  if (initialized || bits < 1 || bits > HUB12_MAX_COLOR_DEPTH)
+    return false;
+  planes = bits;
+  frameSize = bufferSize * planes;
+  return true;
 }
 
 void HUB12_Panel::setBrightness(uint8_t b) {
   brightness = b;
-  if (!initialized)
+  // Di dalam transaksi: diterapkan commitFrame() bersama frame-nya
+  if (!initialized || frameDepth)
     return;
   uint8_t pwm = pgm_read_byte(&dim_curve[b]);
 
@@ -177,17 +279,90 @@ void HUB12_Panel::drawPixel(int16_t x, int16_t y, uint16_t c) {
   uint16_t bytesPerRow = (width() / 8);
   int idx = (y * bytesPerRow) + (x / 8);
   // Write to BACK buffer only (CPU-safe, ISR reads FRONT)
-  if (c)
-    bufferBack[idx] |= (0x80 >> (x & 7));
-  else
-    bufferBack[idx] &= ~(0x80 >> (x & 7));
+  plotPixel(idx, 0x80 >> (x & 7), y, c);
+}
+
+void HUB12_Panel::drawGlyph(const uint8_t *bits, uint8_t w, uint8_t h,
+                            int16_t x, int16_t y, uint16_t c) {
+  for (int16_t row = y; row < y + h; row++)
+    if (row >= 0 && row < height())
+      markRowDirty(row);
+  // Level sama dengan plotPixel(): bit n level -> set/clear di plane n
+  uint16_t level = (c > getMaxLevel()) ? getMaxLevel() : c;
+  for (uint8_t i = 0; i < planes; i++, level >>= 1)
+    blitGlyph(bufferBack + i * bufferSize, width() / 8, width(), height(),
+              bits, w, h, x, y, level & 1);
 }
 
 void HUB12_Panel::fillScreen(uint16_t c) {
-  memset(bufferBack, c ? 0xFF : 0x00, bufferSize);
+  dirtyRows = 0xFFFF;
+  if (planes == 1) {
+    memset(bufferBack, c ? 0xFF : 0x00, bufferSize);
+    return;
+  }
+  uint16_t level = (c > getMaxLevel()) ? getMaxLevel() : c;
+  for (uint8_t i = 0; i < planes; i++, level >>= 1)
+    memset(bufferBack + i * bufferSize, (level & 1) ? 0xFF : 0x00, bufferSize);
 }
 
-void HUB12_Panel::clearScreen() { memset(bufferBack, 0, bufferSize); }
+void HUB12_Panel::clearScreen() {
+  dirtyRows = 0xFFFF;
+  memset(bufferBack, 0, frameSize);
+}
+
+void HUB12_Panel::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c) {
+  fillRect(x, y, w, 1, c);
+}
+
+void HUB12_Panel::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c) {
+  fillRect(x, y, 1, h, c);
+}
+
+void HUB12_Panel::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                           uint16_t c) {
+  if (!HUBRaster::clip(x, y, w, h, width(), height()))
+    return;
+  markRowsDirty(y, h);
+  uint16_t level = (c > getMaxLevel()) ? getMaxLevel() : c;
+  for (uint8_t i = 0; i < planes; i++, level >>= 1)
+    HUBRaster::fillRect(bufferBack + i * bufferSize, width() / 8, width(),
+                        height(), x, y, w, h, level & 1);
+}
+
+void HUB12_Panel::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                             int16_t w, int16_t h, uint16_t c) {
+  blitBitmap(bitmap, true, x, y, w, h, c, 0, false);
+}
+
+void HUB12_Panel::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                             int16_t w, int16_t h, uint16_t c, uint16_t bg) {
+  blitBitmap(bitmap, true, x, y, w, h, c, bg, true);
+}
+
+void HUB12_Panel::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                             int16_t h, uint16_t c) {
+  blitBitmap(bitmap, false, x, y, w, h, c, 0, false);
+}
+
+void HUB12_Panel::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                             int16_t h, uint16_t c, uint16_t bg) {
+  blitBitmap(bitmap, false, x, y, w, h, c, bg, true);
+}
+
+void HUB12_Panel::blitBitmap(const uint8_t *bmp, bool progmem, int16_t x,
+                             int16_t y, int16_t w, int16_t h, uint16_t c,
+                             uint16_t bg, bool opaque) {
+  int16_t cx = x, cy = y, cw = w, ch = h;
+  if (w <= 0 || h <= 0 || !HUBRaster::clip(cx, cy, cw, ch, width(), height()))
+    return;
+  markRowsDirty(cy, ch);
+  uint16_t fg = (c > getMaxLevel()) ? getMaxLevel() : c;
+  uint16_t bl = (bg > getMaxLevel()) ? getMaxLevel() : bg;
+  for (uint8_t i = 0; i < planes; i++, fg >>= 1, bl >>= 1)
+    HUBRaster::blitBitmap(bufferBack + i * bufferSize, width() / 8, width(),
+                          height(), bmp, progmem, x, y, w, h, fg & 1, bl & 1,
+                          opaque);
+}
 
 void HUB12_Panel::drawTextCentered(const String &text) {
   clearScreen();
@@ -204,7 +379,7 @@ void HUB12_Panel::drawTextCentered(const String &text) {
 
   setCursor(centerX, centerY);
   print(text);
-  swapBuffers(true);
+  autoCommit();
 }
 
 int16_t HUB12_Panel::getTextWidth(const String &text) {
@@ -215,100 +390,243 @@ int16_t HUB12_Panel::getTextWidth(const String &text) {
 }
 
 int16_t HUB12_Panel::getTextHeight() {
-  int16_t x1, y1;
-  uint16_t w, h;
-  getTextBounds("Ay", 0, 0, &x1, &y1, &w, &h);
-  return h;
+  // Di-cache per font/ukuran (HUBGlyphGFX::lineHeight)
+  return lineHeight();
 }
 
 void HUB12_Panel::drawTextMultilineCentered(const String &text) {
-  clearScreen();
+  drawTextMultilineCentered(text.c_str());
+}
 
-  const uint8_t MAX_LINES = 8;
-  String lines[MAX_LINES];
-  uint8_t lineCount = 0;
-  String current = "";
-
-  // Parse text by newline
-  for (uint16_t i = 0; i <= text.length(); i++) {
-    char c = text[i];
-    if (c == '\n' || c == '\0') {
-      if (current.length() > 0 && lineCount < MAX_LINES) {
-        lines[lineCount++] = current;
-      }
-      current = "";
-    } else {
-      current += c;
-    }
-  }
+void HUB12_Panel::drawTextMultilineCentered(const char *text) {
+  clearScreen();
 
-  if (lineCount == 0)
+  // Baris dipisah '\n' (baris kosong dilewati), maks 8 baris. Tinggi font
+  // minimal 5x7, jarak antar baris 1px, tiap baris diposisikan dari top
+  // bounds-nya. Layout langsung di text, tanpa String/heap.
+  const HUBTextLayout layout = {8, 7, 1, true, true};
+  if (!drawLinesCentered(text, layout))
     return;
 
-  // Calculate text metrics
-  int16_t fontHeight = getTextHeight();
-  if (fontHeight < 7)
-    fontHeight = 7; // Minimum 5x7 font
+  // Swap buffers atomically to display rendered text
+  autoCommit();
+}
 
-  int16_t lineSpacing = fontHeight + 1;
-  int16_t totalHeight = (lineCount - 1) * lineSpacing + fontHeight;
+void HUB12_Panel::buildWireBuffer(uint8_t *dst, const uint8_t *src,
+                                  uint16_t rows) {
+  // Layout: [scan row 0..3][plane][column byte][row+12, row+8, row+4, row]
+  // Byte sudah di-invert (HUB12 data aktif LOW), baris di luar tinggi = 0xFF.
+  // Urutan ini sama dengan urutan tick ISR, jadi scan() cukup jalan terus.
+  // Paralel: column byte per sub-chain, tiap baris jadi LINE_BITS byte
+  // (byte ke-k semua sub-chain di-interleave, lihat packLines()).
+  uint16_t bytesPerRow = width() / 8;
+  uint16_t segBytes = bytesPerRow / DATA_LINES;
+  uint16_t h = height();
+  const uint8_t stride = 4 * LINE_BITS;
 
-  // Center vertically
-  int16_t verticalMargin = (height() - totalHeight) / 2;
-  if (verticalMargin < 0)
-    verticalMargin = 0;
+  for (uint8_t group = 0; group < 4; group++) {
+    // Lewati scan row yang keempat barisnya tidak berubah
+    if (!(rows & (0x1111 << group))) {
+      dst += wireRowBytes * planes;
+      continue;
+    }
+    for (uint8_t plane = 0; plane < planes; plane++) {
+      const uint8_t *sp = src + plane * bufferSize;
+      for (int8_t q = 3; q >= 0; q--) {
+        uint16_t row = group + q * 4;
+        if (!(rows & (1 << row)))
+          continue;
+        // Baris q ada di slot ke-(3 - q) dari tiap grup 4 slot
+        uint8_t *d = dst + (3 - q) * LINE_BITS;
+        if (row >= h) {
+          for (uint16_t i = 0; i < segBytes; i++, d += stride)
+            memset(d, 0xFF, LINE_BITS);
+          continue;
+        }
+        const uint8_t *line = sp + row * bytesPerRow;
+        if (DATA_LINES == 1) {
+          for (uint16_t i = 0; i < bytesPerRow; i++, d += 4)
+            *d = ~line[i];
+        } else {
+          for (uint16_t i = 0; i < segBytes; i++, d += stride)
+            packLines(d, line + i, segBytes);
+        }
+      }
+      dst += wireRowBytes;
+    }
+  }
+}
 
-  // Draw each line centered
-  for (uint8_t i = 0; i < lineCount; i++) {
-    int16_t lineWidth = getTextWidth(lines[i]);
-    int16_t centerX = (width() - lineWidth) / 2;
-    if (centerX < 0)
-      centerX = 0;
+void HUB12_Panel::packLines(uint8_t *d, const uint8_t *line, uint16_t seg) {
+  // Byte ke-k dari tiap sub-chain -> LINE_BITS byte, satu field per clock
+  // (MSB dulu), bit k field = data line k. Di-invert seperti mode 1 line.
+  uint8_t in[4];
+  for (uint8_t k = 0; k < DATA_LINES; k++)
+    in[k] = ~line[k * seg];
+  uint8_t bit = 0x80;
+  for (uint8_t n = 0; n < LINE_BITS; n++) {
+    uint8_t out = 0;
+    for (uint8_t c = 0; c < 8 / LINE_BITS; c++, bit >>= 1) {
+      uint8_t field = 0;
+      for (uint8_t k = 0; k < DATA_LINES; k++)
+        if (in[k] & bit)
+          field |= 1 << k;
+      out = (out << LINE_BITS) | field;
+    }
+    *d++ = out;
+  }
+}
 
-    // Use actual text bounds for precise Y positioning per line
-    int16_t x1, y1;
-    uint16_t w, h;
-    getTextBounds(lines[i], 0, 0, &x1, &y1, &w, &h);
+void HUB12_Panel::swapBuffers(bool copyFrontToBack) {
+  present(copyFrontToBack, false);
+}
 
-    // Top of this line's bbox should be at: verticalMargin + i * lineSpacing
-    // cursorY + y1 = verticalMargin + i * lineSpacing
-    // cursorY = verticalMargin + i * lineSpacing - y1
-    int16_t lineY = verticalMargin + i * lineSpacing - y1;
-    setCursor(centerX, lineY);
-    print(lines[i]);
-  }
+void HUB12_Panel::beginFrame() {
+  if (frameDepth < 255)
+    frameDepth++;
+}
 
-  // Swap buffers atomically to display rendered text
-  swapBuffers(true);
+void HUB12_Panel::commitFrame(bool copyFrontToBack) {
+  bool txn = frameDepth != 0;
+  if (txn && --frameDepth)
+    return; // Masih di dalam transaksi luar
+  present(copyFrontToBack, true);
+  // Brightness yang diset selama transaksi berlaku bersama frame ini
+  if (txn)
+    setBrightness(brightness);
 }
 
-void HUB12_Panel::swapBuffers(bool copyFrontToBack) {
+void HUB12_Panel::autoCommit() {
+  if (!frameDepth)
+    swapBuffers(true);
+}
+
+void HUB12_Panel::present(bool copyFrontToBack, bool vsync) {
   if (!initialized)
     return;
 
-  // Swap pointers AND optional memcpy ATOMICALLY (disable interrupts to prevent
-  // ISR contention)
-  cli();
+  // Transisi yang belum selesai: front sudah bukan frame lama yang utuh,
+  // frame ini langsung menggantikannya (semua baris ditulis ulang)
+  if (transEffect) {
+    transEffect = HUB12_TRANSITION_NONE;
+    dirtyRows = 0xFFFF;
+  }
+
+  // Baris yang beda antara back (frame baru) dan front (frame tampil)
+  uint16_t changed = dirtyRows;
+  publishRows(bufferBack, changed, vsync);
+
+  // Buffer linear tidak pernah dibaca ISR, jadi swap + memcpy aman tanpa cli
   uint8_t *tmp = bufferFront;
   bufferFront = bufferBack;
   bufferBack = tmp;
 
-  // CRITICAL: memcpy harus atomic (inside cli/sei)
-  // ISR tidak boleh interrupt saat data sedang di-copy
+  // Back sekarang = frame lama, hanya beda di baris `changed`
   if (copyFrontToBack) {
-    memcpy(bufferBack, bufferFront, bufferSize);
+    copyRows(bufferBack, bufferFront, changed);
+    dirtyRows = 0;
+  } else {
+    dirtyRows = changed;
   }
+}
+
+void HUB12_Panel::publishRows(const uint8_t *src, uint16_t rows, bool vsync) {
+  // Konversi ke wire buffer yang tidak dipakai ISR, di luar cli().
+  // Wire buffer itu masih berisi frame lama, jadi baris yang stale
+  // relatif ke front juga ikut ditulis ulang.
+  uint8_t target = freeWire();
+  buildWireBuffer(wire[target], src, rows | wireStale[target]);
+  for (uint8_t i = 0; i < wireCount; i++)
+    wireStale[i] |= rows;
+  wireStale[target] = 0;
+
+  publishWire(target, vsync);
+}
 
-  sei(); // Enable Interrupt SETELAH memcpy selesai
+uint8_t HUB12_Panel::freeWire() {
+  if (wireCount == 2) {
+    // Double buffer: batalkan frame pending (commitFrame) supaya ISR tidak
+    // mengambil buffer yang akan ditulis ulang
+    uint8_t shown;
+    cli();
+    shown = wireShown;
+    wireReady = shown;
+    sei();
+    return shown ^ 1;
+  }
+  // Baca wireShown dulu baru wireReady: ISR hanya bisa mengubah wireShown
+  // menjadi wireReady, jadi hasilnya tidak pernah buffer yang sedang tampil
+  uint8_t shown = wireShown;
+  uint8_t ready = wireReady;
+  if (shown == ready)
+    return (shown == 2) ? 0 : shown + 1;
+  return 3 - shown - ready;
 }
+
+void HUB12_Panel::publishWire(uint8_t index, bool vsync) {
+  if (vsync || wireCount == 3) {
+    // Lock-free: satu store byte (atomic di AVR), ISR ambil di awal frame
+    wireReady = index;
+    return;
+  }
+  // Double buffer: tukar langsung secara atomic (cli window beberapa cycle)
+  cli();
+  wireFront = wire[index];
+  wireShown = index;
+  wireReady = index;
+  sei();
+}
+
+uint32_t HUB12_Panel::getFrameCount() const {
+  uint32_t n;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { n = frameCount; }
+  return n;
+}
+
+uint32_t HUB12_Panel::getFramePeriodUs() const {
+  // Timer1 prescaler 8 @ 16 MHz = 0.5 us per tick, 4 scan row per frame
+  uint32_t ticks = (uint32_t)scanTicks * scanSlices * getMaxLevel();
+  return (4 * ticks) / 2;
+}
+
+void HUB12_Panel::waitForVblank() {
+  if (!initialized)
+    return;
+  uint32_t start = getFrameCount();
+  while (getFrameCount() == start)
+    ;
+}
+
+void HUB12_Panel::copyRows(uint8_t *dst, const uint8_t *src, uint16_t rows) {
+  if (rows == 0xFFFF) {
+    memcpy(dst, src, frameSize);
+    return;
+  }
+  uint16_t bytesPerRow = width() / 8;
+  for (uint16_t row = 0; row < (uint16_t)height() && rows; row++, rows >>= 1) {
+    if (!(rows & 1))
+      continue;
+    uint16_t off = row * bytesPerRow;
+    for (uint8_t plane = 0; plane < planes; plane++, off += bufferSize)
+      memcpy(dst + off, src + off, bytesPerRow);
+  }
+}
+
 // ==========================================================
 // RUNNING TEXT / SCROLLING IMPLEMENTATION
 // ==========================================================
 
 void HUB12_Panel::startScrolling(const String &text, uint16_t speed) {
+  endStripScroll();
+  freeTicker();
   scrollText = text;
-  scrollSpeed = (speed > 0) ? speed : 1;
+  // 1 pixel per 40 ms = 25 px/detik
+  scrollRate = ((speed > 0) ? speed : 1) * (25 << 8);
   scrollX = width();
+  scrollPos = 0;
+  scrollRem = 0;
+  scrollShown = 0;
+  scrollDropped = 0;
 
   // *** PENTING: Matikan Text Wrap ***
   // Tanpa ini, teks akan terbelah saat sebagian di luar layar
@@ -316,46 +634,1070 @@ void HUB12_Panel::startScrolling(const String &text, uint16_t speed) {
 
   isScrolling = true;
   lastScrollTime = millis();
+
+  measureScroll();
+  // Render sekali ke strip; kalau tidak muat, updateScrolling() render
+  // ulang tiap langkah seperti biasa. Seamless: strip baru dipakai setelah
+  // putaran pertama, sebelum itu kepala teks masuk dari kanan sendirian.
+  scrollLead = scrollLeadIn();
+  if (!scrollLead)
+    beginStripScroll();
+}
+
+void HUB12_Panel::startScrolling(const String &text, uint16_t speed,
+                                 bool seamless, uint16_t gap) {
+  // Cukup simpan flag: startScrolling() membangun strip dari awal
+  scrollSeamless = seamless;
+  scrollGap = gap;
+  startScrolling(text, speed);
 }
 
 void HUB12_Panel::stopScrolling() {
+  // Scroll di ISR: panel menampilkan strip, wire buffer masih frame lama.
+  // Setelah strip dilepas, semua baris dibangun ulang dari back buffer
+  // supaya gambar selama scroll tidak hilang.
+  bool isrStrip = stripNext != nullptr;
+  endStripScroll();
+  freeTicker();
   isScrolling = false;
   scrollText = "";
   scrollX = 0;
+  if (isrStrip) {
+    dirtyRows = 0xFFFF;
+    if (!frameDepth)
+      present(true, true); // Di dalam transaksi: commitFrame() yang publish
+  }
+}
+
+// ==========================================================
+// TICKER STREAMING (ring buffer)
+// ==========================================================
+
+// Marker jeda di ring: byte berikutnya = lebar jeda (pixel). Teks yang
+// masuk tidak pernah berisi control char (diganti spasi).
+#define HUB12_TICKER_PAD 0x01
+
+bool HUB12_Panel::startTicker() {
+  stopScrolling();
+  tickerRing = new uint8_t[HUB12_TICKER_RING];
+  if (!tickerRing)
+    return false;
+  tickerHead = 0;
+  tickerCount = 0;
+  tickerX = width();
+  tickerTail = width();
+
+  setTextWrap(false);
+  scrollPos = 0;
+  scrollRem = 0;
+  scrollDropped = 0;
+  isScrolling = true;
+  lastScrollTime = millis();
+  measureTicker();
+  return true;
+}
+
+void HUB12_Panel::freeTicker() {
+  delete[] tickerRing;
+  tickerRing = nullptr;
+  tickerCount = 0;
+}
+
+bool HUB12_Panel::appendTicker(const char *text) {
+  if (!tickerRing || !text || !*text)
+    return false;
+
+  // Item masuk dari tepi kanan: kalau ekor sudah kelihatan, jeda
+  // diperpanjang sampai tepi kanan layar
+  int32_t pad = 0;
+  if (tickerCount) {
+    pad = scrollGap;
+    if (tickerTail + pad < width())
+      pad = width() - tickerTail;
+  } else {
+    tickerX = width();
+    tickerTail = width();
+  }
+
+  // Semua atau tidak sama sekali: marker jeda 2 byte per 255 pixel
+  uint16_t len = strlen(text);
+  uint32_t need = len + 2 * ((pad + 254) / 255);
+  if (need > (uint32_t)(HUB12_TICKER_RING - tickerCount))
+    return false;
+
+  uint16_t i = (tickerHead + tickerCount) % HUB12_TICKER_RING;
+  tickerTail += pad;
+  for (; pad > 0; pad -= 255) {
+    tickerRing[i] = HUB12_TICKER_PAD;
+    i = (i + 1) % HUB12_TICKER_RING;
+    tickerRing[i] = (pad > 255) ? 255 : pad;
+    i = (i + 1) % HUB12_TICKER_RING;
+  }
+  for (const char *p = text; *p; p++) {
+    uint8_t c = (uint8_t)*p < ' ' ? ' ' : *p;
+    int16_t adv, right;
+    glyphMetrics(gfxFont, textsize_x, c, adv, right);
+    tickerTail += adv;
+    tickerRing[i] = c;
+    i = (i + 1) % HUB12_TICKER_RING;
+  }
+  tickerCount += need;
+  return true;
+}
+
+void HUB12_Panel::glyphMetrics(const GFXfont *font, uint8_t size, uint8_t c,
+                               int16_t &adv, int16_t &right, int16_t *left) {
+  // Sama dengan cursor_x yang dimajukan write()
+  int16_t l = 0;
+  if (!font) {
+    adv = right = 6 * size;
+  } else {
+    uint8_t first = pgm_read_byte(&font->first);
+    if (c < first || c > pgm_read_byte(&font->last)) {
+      adv = right = 0;
+    } else {
+      const GFXglyph *glyph =
+          (const GFXglyph *)pgm_read_ptr(&font->glyph) + (c - first);
+      adv = (uint8_t)pgm_read_byte(&glyph->xAdvance) * size;
+      l = (int8_t)pgm_read_byte(&glyph->xOffset) * size;
+      right = l + (uint8_t)pgm_read_byte(&glyph->width) * size;
+    }
+  }
+  if (left)
+    *left = l;
+}
+
+void HUB12_Panel::measureTicker() {
+  // Satu baseline untuk semua item: center bounds huruf besar + descender
+  int16_t x1, y1;
+  uint16_t w, h;
+  getTextBounds("Ag", 0, 0, &x1, &y1, &w, &h);
+  scrollY = (height() - h) / 2 - y1;
+  scrollFont = gfxFont;
+  scrollSizeX = textsize_x;
+  scrollSizeY = textsize_y;
+  tickerFull = true; // Baseline/advance berubah: window lama tidak valid
+
+  // Advance glyph ikut berubah: hitung ulang posisi ekor
+  tickerTail = tickerX;
+  uint16_t i = tickerHead;
+  for (uint16_t n = tickerCount; n > 0; n--) {
+    uint8_t c = tickerRing[i];
+    i = (i + 1) % HUB12_TICKER_RING;
+    if (c == HUB12_TICKER_PAD) {
+      tickerTail += tickerRing[i];
+      i = (i + 1) % HUB12_TICKER_RING;
+      n--;
+      continue;
+    }
+    int16_t adv, right;
+    glyphMetrics(gfxFont, textsize_x, c, adv, right);
+    tickerTail += adv;
+  }
+}
+
+void HUB12_Panel::updateTicker(uint16_t px) {
+  if (scrollFont != gfxFont || scrollSizeX != textsize_x ||
+      scrollSizeY != textsize_y)
+    measureTicker();
+  if (px == 0)
+    return; // Belum geser satu pixel penuh
+  scrollDropped += px - 1;
+  tickerX -= px;
+  tickerTail -= px;
+
+  // Buang glyph (dan jeda) yang seluruhnya sudah lewat tepi kiri
+  bool popped = false;
+  while (tickerCount) {
+    uint8_t c = tickerRing[tickerHead];
+    uint8_t n = 1;
+    int16_t adv, right;
+    if (c == HUB12_TICKER_PAD) {
+      adv = right = tickerRing[(tickerHead + 1) % HUB12_TICKER_RING];
+      n = 2;
+    } else {
+      glyphMetrics(gfxFont, textsize_x, c, adv, right);
+    }
+    if (tickerX + adv > 0 || tickerX + right > 0)
+      break;
+    tickerX += adv;
+    tickerHead = (tickerHead + n) % HUB12_TICKER_RING;
+    tickerCount -= n;
+    popped = true;
+  }
+  if (!tickerCount) {
+    // Kosong: tetap di tepi kanan supaya item berikutnya masuk dari kanan
+    tickerX = width();
+    tickerTail = width();
+    if (!popped)
+      return; // Layar sudah kosong
+  }
+
+  // Back buffer = window langkah lalu (present() menyalin front ke back).
+  // Geser window itu, lalu gambar hanya glyph yang ink-nya kena kolom yang
+  // baru masuk di kanan. Render penuh kalau window lama tidak valid: awal
+  // ticker, font/warna berubah, atau back buffer sudah ditulis yang lain.
+  int32_t enter = width() - px;
+  if (tickerFull || textcolor != tickerColor || dirtyRows) {
+    clearScreen();
+    enter = 0;
+    tickerFull = false;
+    tickerColor = textcolor;
+  } else {
+    shiftBackLeft(px);
+  }
+
+  int32_t x = tickerX;
+  uint16_t i = tickerHead;
+  for (uint16_t n = tickerCount; n > 0 && x < width() + 8; n--) {
+    uint8_t c = tickerRing[i];
+    i = (i + 1) % HUB12_TICKER_RING;
+    if (c == HUB12_TICKER_PAD) {
+      x += tickerRing[i];
+      i = (i + 1) % HUB12_TICKER_RING;
+      n--;
+      continue;
+    }
+    int16_t adv, right, left;
+    glyphMetrics(gfxFont, textsize_x, c, adv, right, &left);
+    // Glyph utuh digambar ulang: bagian yang sudah tampil ditulis dengan
+    // level yang sama, jadi hasilnya tidak berubah
+    if (x + right > enter && x + left < width()) {
+      setCursor(x, scrollY);
+      write(c);
+    }
+    x += adv;
+  }
+
+  present(true, true);
+}
+
+void HUB12_Panel::shiftBackLeft(uint16_t px) {
+  // Seperti blitStrip(), tapi sumbernya back buffer sendiri. Baris kosong
+  // tetap kosong dan tidak ditandai dirty, jadi tidak dibangun ulang.
+  uint16_t bytesPerRow = width() / 8;
+  uint16_t skip = px >> 3;
+  uint8_t s = px & 7;
+  for (uint16_t y = 0; y < height(); y++) {
+    uint8_t any = 0;
+    for (uint8_t plane = 0; plane < planes; plane++) {
+      uint8_t *d = bufferBack + plane * bufferSize + y * bytesPerRow;
+      // j >= i: d[j] dan d[j + 1] dibaca sebelum ditimpa
+      for (uint16_t i = 0, j = skip; i < bytesPerRow; i++, j++) {
+        uint8_t v = 0;
+        if (j < bytesPerRow)
+          v = d[j] << s;
+        if (s && j + 1 < bytesPerRow)
+          v |= d[j + 1] >> (8 - s);
+        any |= d[i];
+        d[i] = v;
+      }
+    }
+    if (any)
+      markRowDirty(y);
+  }
+}
+
+void HUB12_Panel::measureScroll() {
+  int16_t x1, y1;
+  uint16_t w, h;
+  getTextBounds(scrollText, 0, 0, &x1, &y1, &w, &h);
+  scrollW = w;
+  scrollX1 = x1;
+  // Precise vertical centering using actual text bounds
+  scrollY = (height() - h) / 2 - y1;
+  scrollFont = gfxFont;
+  scrollSizeX = textsize_x;
+  scrollSizeY = textsize_y;
+}
+
+bool HUB12_Panel::beginStripScroll() {
+  if (!initialized || scrollText.indexOf('\n') >= 0)
+    return false;
+
+  // Strip melingkar satu period: [teks][jeda] (seamless) atau [layar
+  // kosong][teks][jeda 5px] dibulatkan ke byte (mode lama). Lebar canvas
+  // + satu layar + 1 byte supaya window tidak perlu wrap.
+  uint16_t period =
+      scrollSeamless ? scrollPeriod() : (width() + scrollW + 5 + 7) & ~7;
+  uint16_t canvasWidth = (period + width() + 8 + 7) & ~7;
+  if ((uint32_t)(canvasWidth / 8) * 16 > HUB12_SCROLL_STRIP_MAX)
+    return false;
+  GFXcanvas1 *canvas = new GFXcanvas1(canvasWidth, 16);
+  if (!canvas || !canvas->getBuffer()) {
+    delete canvas;
+    return false;
+  }
+
+  // Font dan posisi vertikal sama dengan scroll render ulang
+  canvas->setFont(gfxFont);
+  canvas->setTextSize(textsize_x, textsize_y);
+  canvas->setTextWrap(false);
+  canvas->setTextColor(1);
+  // Offset 0 = kepala teks di tepi kanan layar (kolom width() di strip)
+  printScrollCopies(*canvas, width(), period, canvasWidth);
+
+  scrollStrip = canvas;
+  stripStride = canvasWidth / 8;
+  stripPeriod = period;
+  stripOffset = 0;
+
+  // Kernel strip ISR: mono, satu data line, bit-bang, tanpa time-slicing.
+  // Mode lain blit window strip ke back buffer tiap langkah (blitStrip()).
+  if (planes != 1 || DATA_LINES != 1 || scanSlices != 1 ||
+      backend != HUB12_BITBANG)
+    return true;
+  cli();
+  stripNext = canvas->getBuffer(); // Dipakai ISR mulai frame berikutnya
+  sei();
+  return true;
+}
+
+void HUB12_Panel::endStripScroll() {
+  if (!scrollStrip)
+    return;
+  // Lepas strip dari ISR langsung (bukan di batas frame) supaya aman di-free
+  cli();
+  stripNext = nullptr;
+  stripShown = nullptr;
+  sei();
+  delete scrollStrip;
+  scrollStrip = nullptr;
+}
+
+void HUB12_Panel::blitStrip(uint16_t offset) {
+  // Window [offset, offset + width) dari strip ke back buffer, per byte.
+  // Strip sudah punya ekor satu layar, jadi p[i + 1] tidak pernah wrap.
+  uint16_t bytesPerRow = width() / 8;
+  uint8_t s = offset & 7;
+  const uint8_t *src = scrollStrip->getBuffer() + (offset >> 3);
+  uint16_t level = (textcolor > getMaxLevel()) ? getMaxLevel() : textcolor;
+
+  for (uint8_t plane = 0; plane < planes; plane++, level >>= 1) {
+    uint8_t *d = bufferBack + plane * bufferSize;
+    if (!(level & 1)) {
+      memset(d, 0, bufferSize);
+      continue;
+    }
+    const uint8_t *p = src;
+    for (uint16_t y = 0; y < height(); y++, p += stripStride) {
+      if (s == 0) {
+        memcpy(d, p, bytesPerRow);
+        d += bytesPerRow;
+        continue;
+      }
+      for (uint16_t i = 0; i < bytesPerRow; i++)
+        *d++ = (uint8_t)(p[i] << s) | (uint8_t)(p[i + 1] >> (8 - s));
+    }
+  }
+  dirtyRows = 0xFFFF;
+}
+
+uint16_t HUB12_Panel::scrollPeriod() const {
+  if (scrollSeamless)
+    return (scrollW + scrollGap > 0) ? scrollW + scrollGap : 1;
+  // Masuk dari kanan sampai habis + jeda 5px
+  return width() + scrollW + 6;
+}
+
+uint16_t HUB12_Panel::scrollLeadIn() const {
+  // Kepala mulai di kolom width(). Salinan sebelumnya (x - period) baru
+  // boleh ada setelah posisinya keluar dari kiri layar.
+  int32_t lead = (int32_t)width() + scrollX1 + scrollW - scrollPeriod();
+  return (lead > 0) ? lead : 0;
+}
+
+void HUB12_Panel::printScrollCopies(Adafruit_GFX &gfx, int32_t x,
+                                    uint16_t period, int16_t right,
+                                    bool fromHead) {
+  // Mundur ke salinan pertama yang seluruhnya di kiri kolom 0
+  if (fromHead)
+    x -= period;
+  else
+    while (x + scrollX1 + (int32_t)scrollW > 0)
+      x -= period;
+  for (x += period; x + scrollX1 < right; x += period) {
+    gfx.setCursor(x, scrollY);
+    gfx.print(scrollText);
+  }
+}
+
+void HUB12_Panel::setScrollLoop(bool seamless, uint16_t gap) {
+  scrollSeamless = seamless;
+  scrollGap = gap;
+  if (!isScrolling || tickerRing)
+    return; // Ticker memakai scrollGap untuk item berikutnya
+  // Period berubah: render strip ulang, loop mulai lagi dari kanan
+  endStripScroll();
+  scrollPos = 0;
+  scrollRem = 0;
+  scrollShown = 0;
+  scrollLead = scrollLeadIn();
+  if (!scrollLead)
+    beginStripScroll();
+}
+
+void HUB12_Panel::setScrollRate(uint16_t ppsQ8) {
+  scrollRate = ppsQ8 ? ppsQ8 : 1;
 }
 
 void HUB12_Panel::updateScrolling() {
-  if (!isScrolling || scrollText.length() == 0)
+  // Jangan publish back buffer yang sedang diisi di dalam beginFrame();
+  // waktu tetap jalan, posisi menyusul setelah commit
+  if (!isScrolling || (scrollText.length() == 0 && !tickerRing) ||
+      frameDepth)
     return;
 
+  // Posisi = waktu x kecepatan (Q8.8), tidak tergantung seberapa sering
+  // fungsi ini dipanggil. Lebih dari 60 detik macet dianggap 60 detik
+  // supaya perkalian tetap muat 32 bit.
   unsigned long now = millis();
   unsigned long elapsed = now - lastScrollTime;
+  lastScrollTime = now;
+  if (elapsed > 60000UL)
+    elapsed = 60000UL;
+  uint32_t t = elapsed * scrollRate + scrollRem; // Q8.8 x ms
+  scrollPos += t / 1000;
+  scrollRem = t % 1000; // Sisa pecahan dibawa, kecepatan tidak drift
 
-  if (elapsed >= 40) {
-    scrollX -= scrollSpeed;
-    lastScrollTime = now;
+  if (tickerRing) {
+    // Ticker tidak punya period: ambil pixel utuh, sisa pecahan dibawa
+    uint16_t px = (scrollPos >> 8 > 0xFFFF) ? 0xFFFF : scrollPos >> 8;
+    scrollPos &= 0xFF;
+    updateTicker(px);
+    return;
+  }
+
+  // Font/ukuran berubah sejak teks diukur: ukur dan render strip ulang
+  if (scrollFont != gfxFont || scrollSizeX != textsize_x ||
+      scrollSizeY != textsize_y) {
+    endStripScroll();
+    measureScroll();
+    if (scrollLead)
+      scrollLead = scrollLeadIn();
+    if (!scrollLead)
+      beginStripScroll();
+  }
+
+  // Putaran pertama selesai: salinan di kiri kepala sudah di luar layar,
+  // window sekarang sama dengan loop penuh
+  bool leadDone = scrollLead && scrollPos >> 8 >= scrollLead;
+  if (leadDone) {
+    scrollLead = 0;
+    beginStripScroll();
+  }
 
-    int16_t textWidth = getTextWidth(scrollText);
+  // Panjang satu loop (strip mode lama dibulatkan ke byte). Putaran
+  // pertama tidak di-modulo: posisi = jarak dari kolom width().
+  uint16_t period = scrollStrip ? stripPeriod : scrollPeriod();
+  if (!scrollLead)
+    scrollPos %= (uint32_t)period << 8;
+  uint16_t pos = scrollPos >> 8;
+  if (pos == scrollShown && !leadDone)
+    return; // Belum geser satu pixel penuh
 
-    // Reset loop (+ buffer 5px biar bersih baru muncul lagi)
-    if (scrollX < -(textWidth + 5)) {
-      scrollX = width();
+  // Posisi antara yang tidak sempat tampil = frame scroll yang drop
+  uint16_t step = scrollLead ? pos - scrollShown
+                             : (pos + period - scrollShown % period) % period;
+  if (step)
+    scrollDropped += step - 1;
+  scrollShown = pos;
+
+  if (scrollStrip) {
+    // Teks tidak dirender ulang, cukup geser kolom awal window
+    if (stripNext) {
+      // Scroll di ISR
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { stripOffset = pos; }
+      return;
     }
+    stripOffset = pos;
+    blitStrip(pos);
+    present(true, true);
+    return;
+  }
 
-    clearScreen();
+  scrollX = width() - pos;
+
+  clearScreen();
+
+  // Ukuran teks dari measureScroll(), tidak diukur ulang tiap langkah.
+  // Mode seamless: kepala loop berikutnya ikut digambar di frame yang sama.
+  printScrollCopies(*this, scrollX, period, width(), scrollLead != 0);
+
+  // Commit di batas frame scan supaya scrolling tidak tearing
+  present(true, true);
+}
+
+// ==========================================================
+// MULTI-ZONE LAYOUT
+// ==========================================================
+
+HUB12_Zone *HUB12_Panel::zoneAt(int8_t id) const {
+  return (id >= 0 && id < HUB12_MAX_ZONES) ? zones[id] : nullptr;
+}
+
+int8_t HUB12_Panel::findZone(const char *name) const {
+  for (uint8_t i = 0; i < HUB12_MAX_ZONES; i++)
+    if (zones[i] && strncmp(zones[i]->name, name, HUB12_ZONE_NAME_LEN) == 0)
+      return i;
+  return -1;
+}
+
+uint8_t HUB12_Panel::getZoneCount() const {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < HUB12_MAX_ZONES; i++)
+    if (zones[i])
+      n++;
+  return n;
+}
+
+int8_t HUB12_Panel::addZone(const char *name, int16_t x, int16_t y,
+                            uint16_t w, uint16_t h) {
+  if (!name || !*name || strlen(name) > HUB12_ZONE_NAME_LEN)
+    return -1;
+  // Rect harus utuh di dalam layar (canvas tidak pernah ter-clip panel)
+  if (x < 0 || y < 0 || w == 0 || h == 0 || x + w > width() ||
+      y + h > height())
+    return -1;
+
+  // Nama sudah ada: zone lama diganti (rect baru, konten dikosongkan)
+  int8_t id = findZone(name);
+  if (id >= 0) {
+    removeZone(id);
+  } else {
+    for (id = 0; id < HUB12_MAX_ZONES && zones[id]; id++)
+      ;
+    if (id == HUB12_MAX_ZONES)
+      return -1;
+  }
+
+  HUB12_Zone *z = new HUB12_Zone();
+  if (!z)
+    return -1;
+  z->canvas = new GFXcanvas1(w, h);
+  if (!z->canvas || !z->canvas->getBuffer()) {
+    delete z->canvas;
+    delete z;
+    return -1;
+  }
+  strcpy(z->name, name);
+  z->x = x;
+  z->y = y;
+  z->w = w;
+  z->h = h;
+  z->type = HUB12_ZONE_STATIC;
+  z->dirty = true; // Render pertama mengosongkan area zone
+  z->color = textcolor;
+  z->font = gfxFont;
+  z->textSize = textsize_x;
+  z->interval = 0;
+  z->lastUpdate = millis();
+  z->lastStep = z->lastUpdate;
+  z->text[0] = '\0';
+  z->value = 0;
+  z->rate = 25 << 8;
+  z->pos = 0;
+  z->rem = 0;
+  z->shown = 0;
+  z->textW = 0;
+  z->textY = 0;
+  z->cells = 0;
+  zones[id] = z;
+  return id;
+}
+
+void HUB12_Panel::removeZone(int8_t id) {
+  HUB12_Zone *z = zoneAt(id);
+  if (!z)
+    return;
+  // Area zone dikosongkan, tampil di updateZones() berikutnya
+  fillRect(z->x, z->y, z->w, z->h, 0);
+  zonesCleared = true;
+  delete z->canvas;
+  delete z;
+  zones[id] = nullptr;
+}
+
+void HUB12_Panel::clearZones() {
+  for (uint8_t i = 0; i < HUB12_MAX_ZONES; i++)
+    removeZone(i);
+  zonesCleared = false; // Pemanggil yang menggambar/commit layar berikutnya
+}
+
+bool HUB12_Panel::setZoneText(int8_t id, const char *text) {
+  HUB12_Zone *z = zoneAt(id);
+  if (!z || !text || strlen(text) > HUB12_ZONE_TEXT_LEN)
+    return false;
+  // Teks sama: tidak ada yang perlu dirender ulang
+  if (z->type == HUB12_ZONE_STATIC && strcmp(z->text, text) == 0)
+    return true;
+  z->type = HUB12_ZONE_STATIC;
+  strcpy(z->text, text);
+  z->dirty = true;
+  return true;
+}
+
+bool HUB12_Panel::setZoneScroll(int8_t id, const char *text, uint16_t ppsQ8) {
+  HUB12_Zone *z = zoneAt(id);
+  if (!z || !text || strlen(text) > HUB12_ZONE_TEXT_LEN)
+    return false;
+  z->rate = ppsQ8 ? ppsQ8 : 1;
+  if (z->type == HUB12_ZONE_SCROLL && strcmp(z->text, text) == 0)
+    return true; // Teks sama: scroll jalan terus, hanya kecepatan
+  z->type = HUB12_ZONE_SCROLL;
+  strcpy(z->text, text);
+  z->pos = 0;
+  z->rem = 0;
+  z->shown = 0;
+  z->lastStep = millis();
+  measureZone(z);
+  z->dirty = true;
+  return true;
+}
+
+bool HUB12_Panel::setZoneCounter(int8_t id, int32_t value) {
+  HUB12_Zone *z = zoneAt(id);
+  if (!z)
+    return false;
+  if (z->type == HUB12_ZONE_COUNTER && z->value == value)
+    return true;
+  // Baru jadi counter: layout sel dihitung di render berikutnya
+  if (z->type != HUB12_ZONE_COUNTER)
+    z->cells = 0;
+  z->type = HUB12_ZONE_COUNTER;
+  z->text[0] = '\0';
+  z->value = value;
+  z->dirty = true;
+  return true;
+}
+
+bool HUB12_Panel::addZoneCounter(int8_t id, int32_t delta) {
+  HUB12_Zone *z = zoneAt(id);
+  if (!z)
+    return false;
+  // Zone teks mulai dari 0; di batas int32 berhenti, tidak wrap
+  const int32_t hi = 0x7FFFFFFFL, lo = -hi - 1;
+  int32_t v = (z->type == HUB12_ZONE_COUNTER) ? z->value : 0;
+  if (delta > 0 && v > hi - delta)
+    v = hi;
+  else if (delta < 0 && v < lo - delta)
+    v = lo;
+  else
+    v += delta;
+  return setZoneCounter(id, v);
+}
 
-    // Hitung Center Y yang Presisi
+int32_t HUB12_Panel::getZoneCounter(int8_t id) const {
+  HUB12_Zone *z = zoneAt(id);
+  return (z && z->type == HUB12_ZONE_COUNTER) ? z->value : 0;
+}
+
+bool HUB12_Panel::setZoneStyle(int8_t id, const GFXfont *font, uint8_t size,
+                               uint16_t color) {
+  HUB12_Zone *z = zoneAt(id);
+  if (!z)
+    return false;
+  z->font = font;
+  z->textSize = size ? size : 1;
+  z->color = color;
+  if (z->type == HUB12_ZONE_SCROLL)
+    measureZone(z);
+  z->cells = 0;
+  z->dirty = true;
+  return true;
+}
+
+bool HUB12_Panel::setZoneInterval(int8_t id, uint16_t ms) {
+  HUB12_Zone *z = zoneAt(id);
+  if (!z)
+    return false;
+  z->interval = ms;
+  return true;
+}
+
+void HUB12_Panel::measureZone(HUB12_Zone *z) {
+  GFXcanvas1 &c = *z->canvas;
+  c.setFont(z->font);
+  c.setTextSize(z->textSize);
+  c.setTextWrap(false); // Satu baris, lebar penuh walau melebihi zone
+  int16_t x1, y1;
+  uint16_t w, h;
+  c.getTextBounds(z->text, 0, 0, &x1, &y1, &w, &h);
+  z->textW = w;
+  z->textY = ((int16_t)z->h - (int16_t)h) / 2 - y1;
+}
+
+void HUB12_Panel::renderZone(HUB12_Zone *z) {
+  GFXcanvas1 &c = *z->canvas;
+  c.fillScreen(0);
+  c.setFont(z->font);
+  c.setTextSize(z->textSize);
+  c.setTextWrap(false);
+  c.setTextColor(1);
+
+  if (z->type == HUB12_ZONE_SCROLL) {
+    c.setCursor((int16_t)z->w - z->shown, z->textY);
+    c.print(z->text);
+  } else {
     int16_t x1, y1;
     uint16_t w, h;
-    getTextBounds(scrollText, 0, 0, &x1, &y1, &w, &h);
+    c.getTextBounds(z->text, 0, 0, &x1, &y1, &w, &h);
+    c.setCursor(((int16_t)z->w - (int16_t)w) / 2 - x1,
+                ((int16_t)z->h - (int16_t)h) / 2 - y1);
+    c.print(z->text);
+  }
+  blitZone(z, 0, z->w);
+}
 
-    // Precise vertical centering using actual text bounds
-    int16_t y = (height() - h) / 2 - y1;
+bool HUB12_Panel::renderCounter(HUB12_Zone *z) {
+  GFXcanvas1 &c = *z->canvas;
+  c.setFont(z->font);
+  c.setTextSize(z->textSize);
+  c.setTextWrap(false);
+  c.setTextColor(1);
 
-    setCursor(scrollX, y);
-    print(scrollText);
+  bool full = false;
+  if (!z->cells) {
+    // Lebar sel = glyph terlebar dari 0-9 dan '-' (advance atau lebar ink)
+    uint16_t cw = 1;
+    for (const char *p = "0123456789-"; *p; p++) {
+      int16_t adv, right, left;
+      glyphMetrics(z->font, z->textSize, *p, adv, right, &left);
+      if (adv > (int16_t)cw)
+        cw = adv;
+      if (right - left > (int16_t)cw)
+        cw = right - left;
+    }
+    uint16_t n = z->w / cw;
+    if (n > sizeof(z->digits) - 1)
+      n = sizeof(z->digits) - 1;
+    if (!n)
+      n = 1;
+    int16_t x1, y1;
+    uint16_t w, h;
+    c.getTextBounds("0123456789", 0, 0, &x1, &y1, &w, &h);
+    z->cells = n;
+    z->cellW = cw;
+    z->cellX = ((int16_t)z->w - (int16_t)(n * cw)) / 2;
+    z->cellY = ((int16_t)z->h - (int16_t)h) / 2 - y1;
+    memset(z->digits, ' ', n);
+    c.fillScreen(0);
+    full = true;
+  }
 
-    // Swap dengan copy untuk prevent torn reads saat scrolling
-    swapBuffers(true);
+  // Angka rata kanan di sel; tidak muat -> semua sel '-'
+  uint8_t n = z->cells;
+  char num[12], now[12];
+  ltoa(z->value, num, 10);
+  uint8_t len = strlen(num);
+  if (len > n) {
+    memset(now, '-', n);
+  } else {
+    memset(now, ' ', n - len);
+    memcpy(now + n - len, num, len);
+  }
+
+  int16_t x0 = z->w, x1 = 0; // Kolom sel yang berubah
+  for (uint8_t i = 0; i < n; i++) {
+    if (now[i] == z->digits[i])
+      continue;
+    int16_t cx = z->cellX + i * z->cellW;
+    c.fillRect(cx, 0, z->cellW, z->h, 0);
+    if (now[i] != ' ') {
+      // Ink glyph di tengah sel (bukan advance): tidak pernah keluar ke
+      // sel tetangga, digit sempit (mis. '1') tidak menempel kiri
+      int16_t adv, right, left;
+      glyphMetrics(z->font, z->textSize, now[i], adv, right, &left);
+      c.setCursor(cx + ((int16_t)z->cellW - (right - left)) / 2 - left,
+                  z->cellY);
+      c.write(now[i]);
+    }
+    z->digits[i] = now[i];
+    if (cx < x0)
+      x0 = cx;
+    x1 = cx + z->cellW;
+  }
+
+  if (full)
+    blitZone(z, 0, z->w);
+  else if (x0 < x1)
+    blitZone(z, x0, x1);
+  return full || x0 < x1;
+}
+
+void HUB12_Panel::blitZone(HUB12_Zone *z, int16_t x0, int16_t x1) {
+  if (x0 < 0)
+    x0 = 0;
+  if (x1 > (int16_t)z->w)
+    x1 = z->w;
+  if (x0 >= x1)
+    return;
+
+  // Byte canvas yang kena [x0, x1), padding kanan canvas tidak ikut
+  uint16_t stride = (z->w + 7) / 8;
+  uint16_t b0 = x0 >> 3;
+  int16_t w = (((x1 - 1) >> 3) - b0 + 1) * 8;
+  if (b0 * 8 + w > (int16_t)z->w)
+    w = z->w - b0 * 8;
+  const uint8_t *src = z->canvas->getBuffer() + b0;
+
+  // Canvas ke tiap plane: bit 1 = bit level warna, bit 0 = gelap
+  markRowsDirty(z->y, z->h);
+  uint16_t level = (z->color > getMaxLevel()) ? getMaxLevel() : z->color;
+  for (uint8_t i = 0; i < planes; i++, level >>= 1) {
+    uint8_t *dst = bufferBack + i * bufferSize;
+    if (w == (int16_t)z->w) {
+      HUBRaster::blitBitmap(dst, width() / 8, width(), height(), src, false,
+                            z->x, z->y, z->w, z->h, level & 1, false, true);
+      continue;
+    }
+    // Sebagian kolom: stride canvas beda dengan lebar blit, per baris
+    for (uint16_t j = 0; j < z->h; j++)
+      HUBRaster::blitBitmap(dst, width() / 8, width(), height(),
+                            src + j * stride, false, z->x + b0 * 8, z->y + j,
+                            w, 1, level & 1, false, true);
+  }
+}
+
+void HUB12_Panel::updateZones() {
+  // Sama seperti updateScrolling(): tidak publish di dalam beginFrame()
+  if (!initialized || frameDepth)
+    return;
+
+  unsigned long now = millis();
+  bool changed = zonesCleared;
+  zonesCleared = false;
+
+  for (uint8_t i = 0; i < HUB12_MAX_ZONES; i++) {
+    HUB12_Zone *z = zones[i];
+    if (!z)
+      continue;
+    // Interval sejak render terakhir belum lewat: zone tidak disentuh
+    if (now - z->lastUpdate < z->interval)
+      continue;
+
+    if (z->type == HUB12_ZONE_SCROLL) {
+      // Masuk dari kanan zone sampai habis + jeda 5px, posisi dari waktu
+      // sejak langkah terakhir (bukan render terakhir)
+      unsigned long elapsed = now - z->lastStep;
+      z->lastStep = now;
+      if (elapsed > 60000UL)
+        elapsed = 60000UL;
+      uint32_t t = elapsed * z->rate + z->rem;
+      uint16_t period = z->w + z->textW + 6;
+      z->pos = (z->pos + t / 1000) % ((uint32_t)period << 8);
+      z->rem = t % 1000;
+      uint16_t p = z->pos >> 8;
+      if (p != z->shown) {
+        z->shown = p;
+        z->dirty = true;
+      }
+    }
+    if (!z->dirty)
+      continue;
+    // Interval dihitung dari render yang benar-benar menggambar
+    if (z->type == HUB12_ZONE_COUNTER) {
+      if (renderCounter(z)) {
+        changed = true;
+        z->lastUpdate = now;
+      }
+    } else {
+      renderZone(z);
+      changed = true;
+      z->lastUpdate = now;
+    }
+    z->dirty = false;
+  }
+
+  // Satu commit untuk semua zone yang berubah di langkah ini
+  if (changed)
+    present(true, true);
+}
+
+// ==========================================================
+// TRANSITION EFFECTS
+// ==========================================================
+
+// Galois LFSR periode maksimal (2^n - 1) untuk n = 2..16 bit
+static const uint16_t transLfsrTaps[] PROGMEM = {
+    0x0003, 0x0006, 0x000C, 0x0014, 0x0030, 0x0060, 0x00B8, 0x0110,
+    0x0240, 0x0500, 0x0829, 0x100D, 0x2015, 0x6000, 0xD008};
+
+bool HUB12_Panel::commitTransition(uint8_t effect, uint16_t ms) {
+  bool txn = frameDepth != 0;
+  if (txn && --frameDepth)
+    return false; // Masih di dalam transaksi luar
+
+  if (!initialized || ms == 0 || effect == HUB12_TRANSITION_NONE ||
+      effect > HUB12_TRANSITION_DISSOLVE) {
+    present(true, true);
+  } else {
+    // Mulai dari yang sedang tampil, termasuk transisi yang belum selesai
+    transEffect = effect;
+    transDuration = ms;
+    transStart = millis();
+    transPos = 0;
+    switch (effect) {
+    case HUB12_TRANSITION_SLIDE_UP:
+      transTotal = height();
+      break;
+    case HUB12_TRANSITION_CURTAIN:
+      transTotal = width() / 2;
+      break;
+    case HUB12_TRANSITION_DISSOLVE: {
+      transTotal = width() * height();
+      uint8_t n = 2;
+      while (n < 16 && ((1UL << n) - 1) < transTotal)
+        n++;
+      transTaps = pgm_read_word(&transLfsrTaps[n - 2]);
+      transLfsr = 1;
+      break;
+    }
+    default:
+      transTotal = width();
+      break;
+    }
   }
-}
\ No newline at end of file
+
+  // Brightness yang diset selama transaksi berlaku bersama frame ini
+  if (txn)
+    setBrightness(brightness);
+  return true;
+}
+
+void HUB12_Panel::updateTransition() {
+  // Sama seperti updateScrolling(): tidak publish di dalam beginFrame()
+  if (!transEffect || !initialized || frameDepth)
+    return;
+
+  // Posisi dari waktu: langkah yang telat digabung, tidak melambat
+  unsigned long elapsed = millis() - transStart;
+  uint16_t to = (elapsed >= transDuration)
+                    ? transTotal
+                    : (uint32_t)transTotal * elapsed / transDuration;
+  if (to == transPos)
+    return;
+
+  uint16_t rows = stepTransition(transPos, to);
+  transPos = to;
+  if (to == transTotal) {
+    // Front sudah sama persis dengan back
+    transEffect = HUB12_TRANSITION_NONE;
+    dirtyRows = 0;
+  }
+  if (rows)
+    publishRows(bufferFront, rows, true);
+}
+
+uint16_t HUB12_Panel::copyColumns(int16_t x0, int16_t x1) {
+  if (x0 < 0)
+    x0 = 0;
+  if (x1 > width())
+    x1 = width();
+  if (x0 >= x1)
+    return 0;
+
+  // Byte pertama/terakhir kolom [x0, x1) dan pixel yang kena di tiap byte
+  uint16_t stride = width() / 8;
+  uint16_t i0 = x0 >> 3, i1 = (x1 - 1) >> 3;
+  uint8_t lm = 0xFF >> (x0 & 7);
+  uint8_t rm = 0xFF << (7 - ((x1 - 1) & 7));
+
+  uint16_t rows = 0;
+  for (uint8_t plane = 0; plane < planes; plane++) {
+    uint8_t *f = bufferFront + plane * bufferSize;
+    const uint8_t *b = bufferBack + plane * bufferSize;
+    for (uint16_t y = 0; y < (uint16_t)height();
+         y++, f += stride, b += stride) {
+      uint8_t diff = 0;
+      for (uint16_t i = i0; i <= i1; i++) {
+        uint8_t m = 0xFF;
+        if (i == i0)
+          m &= lm;
+        if (i == i1)
+          m &= rm;
+        uint8_t d = (f[i] ^ b[i]) & m;
+        f[i] ^= d;
+        diff |= d;
+      }
+      if (diff)
+        rows |= 1 << y;
+    }
+  }
+  return rows;
+}
+
+uint16_t HUB12_Panel::stepTransition(uint16_t from, uint16_t to) {
+  uint16_t w = width(), h = height();
+  uint16_t stride = w / 8;
+  uint16_t all = (h >= 16) ? 0xFFFF : (1 << h) - 1;
+  uint16_t k = to - from;
+
+  switch (transEffect) {
+  case HUB12_TRANSITION_WIPE:
+    return copyColumns(from, to);
+
+  case HUB12_TRANSITION_CURTAIN: {
+    int16_t mid = w / 2;
+    return copyColumns(mid - to, mid - from) | copyColumns(mid + from, mid + to);
+  }
+
+  case HUB12_TRANSITION_SLIDE_LEFT: {
+    // Geser front k kolom ke kiri, kolom kanan diisi kolom back [from, to)
+    uint16_t q = k >> 3;
+    uint8_t r = k & 7;
+    for (uint8_t plane = 0; plane < planes; plane++) {
+      uint8_t *line = bufferFront + plane * bufferSize;
+      const uint8_t *src = bufferBack + plane * bufferSize;
+      for (uint16_t y = 0; y < h; y++, line += stride, src += stride) {
+        for (uint16_t i = 0; i < stride; i++) {
+          uint8_t hi = (i + q < stride) ? line[i + q] : 0;
+          uint8_t lo = (i + q + 1 < stride) ? line[i + q + 1] : 0;
+          line[i] = r ? (uint8_t)(hi << r) | (lo >> (8 - r)) : hi;
+        }
+        for (uint16_t j = 0; j < k; j++) {
+          uint16_t sx = from + j, dx = w - k + j;
+          if (src[sx >> 3] & (0x80 >> (sx & 7)))
+            line[dx >> 3] |= 0x80 >> (dx & 7);
+        }
+      }
+    }
+    return all;
+  }
+
+  case HUB12_TRANSITION_SLIDE_UP:
+    // Geser front k baris ke atas, baris bawah diisi baris back [from, to)
+    for (uint8_t plane = 0; plane < planes; plane++) {
+      uint8_t *f = bufferFront + plane * bufferSize;
+      memmove(f, f + k * stride, (h - k) * stride);
+      memcpy(f + (h - k) * stride, bufferBack + plane * bufferSize +
+                                       from * stride,
+             k * stride);
+    }
+    return all;
+
+  case HUB12_TRANSITION_DISSOLVE: {
+    // Urutan LFSR: tiap pixel tepat sekali, nilai di luar layar dilewati
+    uint16_t rows = 0;
+    while (k) {
+      uint16_t idx = transLfsr - 1;
+      transLfsr = (transLfsr >> 1) ^ ((transLfsr & 1) ? transTaps : 0);
+      if (idx >= transTotal)
+        continue;
+      k--;
+      uint16_t y = idx / w, x = idx % w;
+      uint16_t off = y * stride + (x >> 3);
+      uint8_t m = 0x80 >> (x & 7);
+      for (uint8_t plane = 0; plane < planes; plane++, off += bufferSize) {
+        uint8_t d = (bufferFront[off] ^ bufferBack[off]) & m;
+        if (d) {
+          bufferFront[off] ^= d;
+          rows |= 1 << y;
+        }
+      }
+    }
+    return rows;
+  }
+  }
+  return 0;
+}
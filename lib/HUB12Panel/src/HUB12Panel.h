@@ -1,59 +1,817 @@
 #ifndef HUB12_PANEL_H
 #define HUB12_PANEL_H
 
+#include "HUBGlyph.h"
+#include "HUBPins.h"
+#include "HUBRaster.h"
 #include <Adafruit_GFX.h>
 #include <Arduino.h>
 #include <avr/pgmspace.h>
+#include <util/atomic.h>
 
 #define OE_ACTIVE_LOW true
 
+// Wiring yang dipakai scan ISR, di-resolve ke port/bit saat compile
+// (lihat HUBPins.h). Ganti lewat build_flags, contoh: -DHUB12_PIN_R=6
+// Pin yang dikirim ke begin() harus sama dengan nilai di sini.
+#ifndef HUB12_PIN_R
+#define HUB12_PIN_R 5
+#endif
+#ifndef HUB12_PIN_CLK
+#define HUB12_PIN_CLK 7
+#endif
+#ifndef HUB12_PIN_LAT
+#define HUB12_PIN_LAT 8
+#endif
+#ifndef HUB12_PIN_A
+#define HUB12_PIN_A PIN_A0
+#endif
+#ifndef HUB12_PIN_B
+#define HUB12_PIN_B PIN_A1
+#endif
+
+// Output paralel: 1..4 data line di port yang sama, CLK/LAT/OE/A/B dipakai
+// bersama. Line k ada di bit port (HUB12_PIN_R + k) dan men-drive sub-chain
+// ke-k (chain dibagi rata dari kiri ke kanan). Contoh Mega, 4 line di
+// PA0..PA3 (pin 22..25): -DHUB12_DATA_LINES=4 -DHUB12_PIN_R=22
+#ifndef HUB12_DATA_LINES
+#define HUB12_DATA_LINES 1
+#endif
+
+// Mode grayscale (BCM): refresh target (Hz). Lama tampil plane terkecil
+// (BASE, tick Timer1 /8 = 0.5 us) dihitung saat begin() supaya
+// 4 baris x (2^depth - 1) x BASE tetap >= target: depth 4 -> BASE 277
+// (138 us). Plane n tampil (BASE << n) tick.
+// Trade-off: BASE tidak boleh lebih pendek dari waktu shift satu baris
+// (HUB12_SHIFT_TICKS_PER_BYTE per byte, ~160 us untuk 64 px bit-bang), jadi
+// chain panjang / depth tinggi refresh-nya turun di bawah target (64 px
+// depth 4: ~104 Hz). Pakai depth 3 atau backend MSPIM untuk chain panjang.
+#ifndef HUB12_BCM_REFRESH_HZ
+#define HUB12_BCM_REFRESH_HZ 120
+#endif
+// Opsional: -DHUB12_BCM_BASE_TICKS=n memaksa BASE tetap (tanpa hitung
+// otomatis di atas)
+#define HUB12_MAX_COLOR_DEPTH 4
+
+// Scroll di ISR: batas RAM strip teks (byte). Teks yang lebih panjang
+// memakai scroll render ulang biasa.
+#ifndef HUB12_SCROLL_STRIP_MAX
+#define HUB12_SCROLL_STRIP_MAX 1024
+#endif
+
+// Ticker streaming: ukuran ring buffer teks (byte), dialokasi sekali saat
+// startTicker(). Item baru ditolak kalau ring penuh.
+#ifndef HUB12_TICKER_RING
+#define HUB12_TICKER_RING 512
+#endif
+
+// Time-slicing: perkiraan waktu shift satu byte wire buffer dalam tick
+// Timer1 (~5 us). Periode slice tidak pernah lebih pendek dari 2x waktu
+// shift slice, jadi ISR paling banyak makan ~50% CPU (refresh yang turun).
+#ifndef HUB12_SHIFT_TICKS_PER_BYTE
+#define HUB12_SHIFT_TICKS_PER_BYTE 10
+#endif
+
+// Backend shift data di scan ISR (pilih dengan setScanBackend())
+enum HUB12_Backend : uint8_t {
+  HUB12_BITBANG = 0, // Software, pin HUB12_PIN_R / HUB12_PIN_CLK
+  HUB12_MSPIM = 1    // USART sebagai SPI master (Mega saja)
+};
+
 struct HUB12_Config {
   int8_t r, clk, lat, oe, a, b;
   uint16_t width, height, chain;
 };
 
-class HUB12_Panel : public Adafruit_GFX {
+// Multi-zone: jumlah zone maksimal dan panjang nama (tanpa '\0'). Zone
+// dialokasi saat addZone(), slot kosong hanya makan satu pointer.
+#ifndef HUB12_MAX_ZONES
+#define HUB12_MAX_ZONES 4
+#endif
+#define HUB12_ZONE_NAME_LEN 8
+// Panjang teks zone (tanpa '\0'), disimpan di array tetap per zone
+#ifndef HUB12_ZONE_TEXT_LEN
+#define HUB12_ZONE_TEXT_LEN 32
+#endif
+
+enum HUB12_ZoneType : uint8_t {
+  HUB12_ZONE_STATIC = 0, // Teks diam, center di zone
+  HUB12_ZONE_SCROLL = 1, // Running text di dalam zone
+  HUB12_ZONE_COUNTER = 2 // Angka (int32), sel digit tetap di tengah zone
+};
+
+// Efek commitTransition()
+enum HUB12_Transition : uint8_t {
+  HUB12_TRANSITION_NONE = 0,       // Cut biasa
+  HUB12_TRANSITION_WIPE = 1,       // Frame baru menyapu dari kiri
+  HUB12_TRANSITION_SLIDE_LEFT = 2, // Frame lama didorong keluar ke kiri
+  HUB12_TRANSITION_SLIDE_UP = 3,   // Frame lama didorong keluar ke atas
+  HUB12_TRANSITION_CURTAIN = 4,    // Membuka dari tengah ke kiri-kanan
+  HUB12_TRANSITION_DISSOLVE = 5    // Pixel acak, urutan LFSR
+};
+
+// Satu region layar dengan konten sendiri. Konten dirender ke canvas zone
+// (otomatis ter-clip ke rect zone) lalu di-blit ke back buffer, hanya
+// kalau kontennya berubah dan interval zone sudah lewat.
+struct HUB12_Zone {
+  char name[HUB12_ZONE_NAME_LEN + 1];
+  int16_t x, y;
+  uint16_t w, h;
+  uint8_t type;
+  bool dirty;               // Konten berubah, belum dirender
+  uint16_t color;
+  const GFXfont *font;
+  uint8_t textSize;
+  uint16_t interval;        // Minimal ms antar render (0 = tiap update)
+  unsigned long lastUpdate; // millis() render terakhir (interval)
+  unsigned long lastStep;   // millis() posisi scroll terakhir dihitung
+  GFXcanvas1 *canvas;       // w x h, 1 bit per pixel
+  char text[HUB12_ZONE_TEXT_LEN + 1]; // STATIC / SCROLL
+  int32_t value;            // COUNTER
+  // SCROLL: posisi dari waktu (Q8.8), sama seperti scroll layar penuh
+  uint16_t rate;
+  uint32_t pos;
+  uint16_t rem;
+  uint16_t shown;
+  uint16_t textW;
+  int16_t textY;
+  // COUNTER: sel digit selebar digit terlebar, angka rata kanan. Layout
+  // tetap antar nilai, hanya sel yang karakternya berubah digambar ulang.
+  // cells = 0 -> layout dihitung ulang (zone baru / style berubah).
+  uint8_t cells;
+  uint16_t cellW;
+  int16_t cellX, cellY; // Sel pertama / baseline, relatif ke zone
+  char digits[12];      // Isi sel yang sedang tampil (' ' = kosong)
+};
+
+// Shift satu byte wire buffer. Paralel (LINES > 1): tiap byte berisi
+// 8 / BITS clock, field BITS bit per clock (MSB dulu), bit k field = line k
+// di bit port (R::bit + k). Satu write port men-set semua line sekaligus.
+template <class R, class CLK, uint8_t LINES = 1> struct HUB12_ShiftByte {
+  static const uint8_t BITS = (LINES == 3) ? 4 : LINES;
+  static const uint8_t FIELD = (1 << LINES) - 1;
+  static const uint8_t DATA = FIELD << R::bit;
+
+  template <uint8_t SHIFT>
+  static inline __attribute__((always_inline)) void clock(uint8_t v) {
+    uint8_t out = R::Port::read() & (uint8_t)~DATA;
+    R::Port::write(out | (uint8_t)(((v >> SHIFT) & FIELD) << R::bit));
+    CLK::pulse();
+  }
+
+  static inline __attribute__((always_inline)) void run(uint8_t v) {
+    if (BITS == 2) {
+      clock<6>(v);
+      clock<4>(v);
+      clock<2>(v);
+      clock<0>(v);
+    } else {
+      clock<4>(v);
+      clock<0>(v);
+    }
+  }
+};
+
+// Satu data line: MSB first, bit di-unroll
+template <class R, class CLK> struct HUB12_ShiftByte<R, CLK, 1> {
+  static inline __attribute__((always_inline)) void run(uint8_t v) {
+    R::write(v & 0x80);
+    CLK::pulse();
+    R::write(v & 0x40);
+    CLK::pulse();
+    R::write(v & 0x20);
+    CLK::pulse();
+    R::write(v & 0x10);
+    CLK::pulse();
+    R::write(v & 0x08);
+    CLK::pulse();
+    R::write(v & 0x04);
+    CLK::pulse();
+    R::write(v & 0x02);
+    CLK::pulse();
+    R::write(v & 0x01);
+    CLK::pulse();
+  }
+};
+
+// Shift N byte berturut-turut, di-unroll penuh saat N diketahui compile-time
+template <class R, class CLK, uint8_t LINES, uint16_t N>
+struct HUB12_ShiftBytes {
+  static inline __attribute__((always_inline)) void run(const uint8_t *p) {
+    HUB12_ShiftBytes<R, CLK, LINES, N - 1>::run(p);
+    HUB12_ShiftByte<R, CLK, LINES>::run(p[N - 1]);
+  }
+};
+
+template <class R, class CLK, uint8_t LINES>
+struct HUB12_ShiftBytes<R, CLK, LINES, 0> {
+  static inline void run(const uint8_t *) {}
+};
+
+#if defined(__AVR_ATmega2560__)
+// Backend MSPIM: USART n jadi SPI master, satu byte di-shift hardware
+// sementara CPU menyiapkan byte berikutnya (~1 us per byte di 8 MHz, vs
+// ~5 us bit-bang). Pin ditentukan hardware: R = TXDn, CLK = XCKn.
+// USART0 dipakai Serial. Tidak ada XCKn yang keluar di header Mega standar
+// (XCK0..3 = PE2, PD5, PH2, PJ2), jadi begin() dengan backend MSPIM gagal
+// kecuali XCKn sudah disambung ke CLK panel langsung dari pin chip dan build
+// men-set -DHUB12_MSPIM_XCK_WIRED=1.
+//
+// Known gap: urutan setup dan stream byte hanya dicek terhadap model register
+// di host (test/test_mspim, env native_mspim), belum di simavr atau
+// hardware. Timing UDRE/TXC di model selesai seketika.
+#ifndef HUB12_MSPIM_USART
+#define HUB12_MSPIM_USART 1
+#endif
+#ifndef HUB12_MSPIM_XCK_WIRED
+#define HUB12_MSPIM_XCK_WIRED 0
+#endif
+// UBRR: 0 = F_CPU / 2 (8 MHz), naikkan untuk kabel panjang
+#ifndef HUB12_MSPIM_UBRR
+#define HUB12_MSPIM_UBRR 0
+#endif
+#define HUB12_HAS_MSPIM 1
+
+template <uint8_t N> struct HUB12_Mspim;
+
+#define HUB12_DEFINE_MSPIM(N, XCK_DDR, XCK_BIT, TXD_PIN)                      \
+  template <> struct HUB12_Mspim<N> {                                        \
+    static const int8_t txdPin = TXD_PIN;                                    \
+    static inline void begin() {                                             \
+      UBRR##N = 0;                                                           \
+      XCK_DDR |= (1 << XCK_BIT);                                             \
+      UCSR##N##C = (1 << UMSEL##N##1) | (1 << UMSEL##N##0);                  \
+      UCSR##N##B = (1 << TXEN##N);                                           \
+      UBRR##N = HUB12_MSPIM_UBRR;                                            \
+    }                                                                        \
+    static inline void shift(const uint8_t *p, uint16_t n) {                 \
+      UCSR##N##A = (1 << TXC##N);                                            \
+      while (n--) {                                                          \
+        while (!(UCSR##N##A & (1 << UDRE##N)))                               \
+          ;                                                                  \
+        UDR##N = *p++;                                                       \
+      }                                                                      \
+      while (!(UCSR##N##A & (1 << TXC##N)))                                  \
+        ;                                                                    \
+    }                                                                        \
+  };
+
+// MSPIM mode 0, MSB first: sama dengan urutan bit wire buffer
+HUB12_DEFINE_MSPIM(1, DDRD, 5, 18)
+HUB12_DEFINE_MSPIM(2, DDRH, 2, 16)
+HUB12_DEFINE_MSPIM(3, DDRJ, 2, 14)
+#undef HUB12_DEFINE_MSPIM
+#else
+#define HUB12_HAS_MSPIM 0
+#endif
+
+class HUB12_Panel : public HUBGlyphGFX {
 public:
   static HUB12_Panel *instance;
 
-private:
+protected:
+  typedef HUBPin<HUB12_PIN_R> PinR;
+  typedef HUBPin<HUB12_PIN_CLK> PinCLK;
+  typedef HUBPin<HUB12_PIN_LAT> PinLAT;
+  typedef HUBPin<HUB12_PIN_A> PinA;
+  typedef HUBPin<HUB12_PIN_B> PinB;
+
+#if HUB12_HAS_MSPIM
+  typedef HUB12_Mspim<HUB12_MSPIM_USART> Mspim;
+#endif
+
+  static const uint8_t DATA_LINES = HUB12_DATA_LINES;
+  // Bit per clock di wire buffer (3 line di-pad ke 4 supaya pas satu byte)
+  static const uint8_t LINE_BITS = (DATA_LINES == 3) ? 4 : DATA_LINES;
+  static const uint8_t DATA_MASK = ((1 << DATA_LINES) - 1) << PinR::bit;
+  static_assert(DATA_LINES >= 1 && DATA_LINES <= 4,
+                "HUB12_DATA_LINES must be 1..4");
+  static_assert(PinR::bit + DATA_LINES <= 8,
+                "HUB12 data lines must fit on HUB12_PIN_R's port");
+  static_assert(!HUBSamePort<PinR, PinCLK>::value ||
+                    !(PinCLK::mask & DATA_MASK),
+                "HUB12_PIN_CLK overlaps a data line");
+  static_assert(!HUBSamePort<PinR, PinLAT>::value ||
+                    !(PinLAT::mask & DATA_MASK),
+                "HUB12_PIN_LAT overlaps a data line");
+
   HUB12_Config config;
-  uint8_t *bufferFront;  // ISR reads this (displayed buffer)
+  uint8_t *bufferFront;  // Last published frame (linear)
   uint8_t *bufferBack;   // CPU writes to this (drawing buffer)
-  uint16_t bufferSize;
+  uint8_t *wire[3];      // Wire buffers (shift order, already inverted)
+  const uint8_t *wireFront;   // Wire buffer yang sedang di-scan ISR
+  volatile uint8_t wireShown; // Index wireFront (hanya ditulis ISR / cli)
+  volatile uint8_t wireReady; // Index frame terbaru (hanya ditulis renderer)
+  uint8_t wireCount;     // 2 = double buffer, 3 = triple buffer
+  uint16_t bufferSize;   // Bytes per bit plane
+  uint16_t frameSize;    // bufferSize * planes
+  uint16_t wireRowBytes; // Bytes shifted per scan tick (4 rows interleaved)
+  uint16_t wireSize;     // Bytes per wire buffer (4 * wireRowBytes * planes)
+  uint8_t planes;        // 1 = mono, 2..4 = grayscale BCM
+  uint8_t scanRow;       // Scan row berikutnya (0..3)
+  uint8_t scanPlane;     // Plane BCM berikutnya (0..planes-1)
+  uint16_t scanOffset;   // Posisi ISR di wire buffer
+  uint16_t scanTicks;    // Periode Timer1 per tick (BCM: plane 0)
+  uint16_t sliceMaxBytes;  // Batas byte per ISR (0 = satu baris per ISR)
+  uint16_t sliceBytes;     // Byte per slice, kecuali slice terakhir
+  uint16_t lastSliceBytes; // Byte slice terakhir (yang latch)
+  uint8_t scanSlices;    // Slice per baris (1 = tanpa time-slicing)
+  uint8_t scanSlice;     // Slice berikutnya (0..scanSlices-1)
+  uint8_t backend;       // HUB12_Backend
+  uint16_t dirtyRows;    // Bit per baris: back buffer beda dengan front
+  uint16_t wireStale[3]; // Bit per baris: wire[i] beda dengan front
+  volatile uint32_t frameCount; // Naik tiap scan frame selesai (vblank)
   volatile bool initialized;
   uint8_t brightness;
+  uint8_t frameDepth; // beginFrame() yang belum di-commit (0 = tidak ada)
   
   // Untuk running text
   String scrollText;
   int16_t scrollX;
-  uint16_t scrollSpeed;  // pixel per frame (default: 1)
+  uint16_t scrollRate;   // pixel per detik, fixed-point Q8.8
+  uint32_t scrollPos;    // Posisi scroll (pixel Q8.8) dalam satu loop
+  uint16_t scrollRem;    // Sisa pembagian /1000 dari langkah sebelumnya
+  uint16_t scrollShown;  // Posisi pixel yang terakhir dirender
+  uint32_t scrollDropped; // Posisi pixel yang terlewat (tidak pernah tampil)
   unsigned long lastScrollTime;
   bool isScrolling;
 
+  // Ukuran scrollText, diukur sekali per teks/font (measureScroll())
+  uint16_t scrollW;               // Lebar bounds teks
+  int16_t scrollX1;               // Kiri bounds relatif cursor
+  int16_t scrollY;                // Cursor Y supaya teks center vertikal
+  const GFXfont *scrollFont;      // Font/ukuran saat teks diukur
+  uint8_t scrollSizeX, scrollSizeY;
+  bool scrollSeamless; // Loop tanpa layar kosong (setScrollLoop())
+  uint16_t scrollGap;  // Jarak ekor -> kepala teks berikutnya (pixel)
+  // Putaran pertama seamless: sisa pixel sampai salinan di kiri kepala
+  // pertama seharusnya sudah ada (0 = loop penuh, strip boleh dipakai)
+  uint16_t scrollLead;
+
+  // Scroll strip: teks dirender sekali ke strip melingkar. ISR menggeser
+  // window strip per kolom (mode mono), mode lain blit window ke back
+  // buffer. Main loop cukup menaikkan stripOffset.
+  GFXcanvas1 *scrollStrip;           // null = scroll render ulang biasa
+  const uint8_t *volatile stripNext; // Strip ISR frame berikut, null = blit
+  const uint8_t *stripShown;         // Strip yang sedang di-scan ISR
+  uint16_t stripStride;              // Byte per baris strip
+  uint16_t stripPeriod;              // Panjang loop strip (pixel)
+  volatile uint16_t stripOffset;     // Kolom kiri window (ditulis main loop)
+  uint16_t stripPos;                 // stripOffset yang di-latch awal frame
+
+  // Ticker: teks mengalir lewat ring buffer, glyph di head dibuang begitu
+  // lewat tepi kiri. Jeda antar item disimpan sebagai marker di ring.
+  uint8_t *tickerRing;  // null = bukan mode ticker
+  uint16_t tickerHead;  // Index byte pertama (glyph paling kiri)
+  uint16_t tickerCount; // Byte terpakai
+  int16_t tickerX;      // X layar glyph di head
+  int32_t tickerTail;   // X layar setelah glyph terakhir (item berikutnya)
+  uint16_t tickerColor; // textcolor saat window terakhir digambar
+  bool tickerFull;      // Window berikutnya dirender penuh (bukan digeser)
+
+  // Multi-zone (addZone()), null = slot kosong
+  HUB12_Zone *zones[HUB12_MAX_ZONES];
+  bool zonesCleared; // Ada zone dihapus, area kosongnya belum di-commit
+
+  // Transisi: front = frame yang tampil, diubah bertahap menjadi back
+  // (frame tujuan). transPos = unit (kolom/baris/pixel) yang sudah pindah.
+  uint8_t transEffect; // HUB12_Transition, NONE = tidak ada transisi
+  uint16_t transDuration;
+  unsigned long transStart;
+  uint16_t transPos;
+  uint16_t transTotal;
+  uint16_t transLfsr; // DISSOLVE: state LFSR (pixel berikutnya + 1)
+  uint16_t transTaps;
+
 public:
   HUB12_Panel(uint16_t w, uint16_t h, uint16_t chain = 1);
   bool begin(int8_t r, int8_t clk, int8_t lat, int8_t oe, int8_t a, int8_t b,
              uint16_t w = 32, uint16_t h = 16, uint16_t chain = 1);
-  void scan();
+  void scan(); // Geometri runtime (ISR default)
   void setBrightness(uint8_t b);
+
+  // Grayscale BCM: 1 (mono, default) atau 2..4 bit per pixel. Panggil
+  // SEBELUM begin(). Di mode grayscale warna = level 0..getMaxLevel(),
+  // nilai lebih besar di-clamp ke level penuh (0xFFFF selalu terang penuh).
+  bool setColorDepth(uint8_t bits);
+  uint8_t getColorDepth() const { return planes; }
+  uint16_t getMaxLevel() const { return (1 << planes) - 1; }
+
+  // Triple buffer: swapBuffers() tidak pernah mematikan interrupt. Frame
+  // dipublish dengan satu store index, ISR mengambilnya di awal frame scan
+  // berikutnya. Butuh satu wire buffer tambahan. Panggil SEBELUM begin().
+  bool setTripleBuffering(bool enable);
+
+  // Time-slicing untuk chain panjang: satu baris di-shift dalam beberapa
+  // ISR pendek, maksimal maxBytes byte per ISR, latch di slice terakhir.
+  // Latency interrupt jadi konstan berapapun panjang chain. 0 = off
+  // (default). Panggil SEBELUM begin().
+  bool setScanSliceBytes(uint16_t maxBytes);
+  uint8_t getScanSlices() const { return scanSlices; }
+
+  // HUB12_MSPIM: shift lewat USART (HUB12_MSPIM_USART) di hardware, pin R
+  // ke begin() harus TXDn, pin CLK diabaikan (XCKn). Hanya Mega dan hanya
+  // satu data line. Panggil SEBELUM begin(). begin() gagal tanpa
+  // HUB12_MSPIM_XCK_WIRED=1 (XCKn tidak ada di header Mega).
+  bool setScanBackend(HUB12_Backend b);
+  HUB12_Backend getScanBackend() const { return (HUB12_Backend)backend; }
+
   void drawPixel(int16_t x, int16_t y, uint16_t c) override;
   void fillScreen(uint16_t c) override;
   void clearScreen();
 
+  // Garis/rect/bitmap langsung per byte ke back buffer (bukan per pixel).
+  // drawBitmap: versi const baca PROGMEM, versi non-const baca RAM.
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t c) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t c) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                uint16_t c) override;
+  using Adafruit_GFX::drawBitmap;
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t c);
+  void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w,
+                  int16_t h, uint16_t c, uint16_t bg);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                  int16_t h, uint16_t c);
+  void drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                  int16_t h, uint16_t c, uint16_t bg);
+
   // Helper
   void drawTextCentered(const String &text);
   int16_t getTextWidth(const String &text);
   int16_t getTextHeight();
   void drawTextMultilineCentered(const String &text);
+  void drawTextMultilineCentered(const char *text);
   
-  // Running text
+  // Running text. speed = pixel per 40 ms (lama, = speed * 25 px/detik)
   void startScrolling(const String &text, uint16_t speed = 1);
+  // Sama, sekaligus set mode loop (lihat setScrollLoop()). Strip hanya
+  // dirender sekali, untuk teks baru dengan period yang benar.
+  void startScrolling(const String &text, uint16_t speed, bool seamless,
+                      uint16_t gap = 16);
   void stopScrolling();
   void updateScrolling();  // call this di loop utama
+
+  // Kecepatan scroll dalam pixel per detik, fixed-point Q8.8 (mis. 12.5
+  // px/detik = 3200). Posisi dihitung dari millis(), jadi kalau loop utama
+  // sempat macet teks langsung menyusul ke posisi yang seharusnya.
+  void setScrollRate(uint16_t ppsQ8);
+  uint16_t getScrollRate() const { return scrollRate; }
+  // Jumlah posisi pixel yang terlewat karena updateScrolling() telat
+  uint32_t getScrollDroppedFrames() const { return scrollDropped; }
   bool getScrollingStatus() const { return isScrolling; }  // getter untuk isScrolling
+
+  // Loop seamless: kepala teks langsung menyusul ekornya setelah `gap`
+  // pixel, tanpa menunggu layar kosong. false = mode lama (teks keluar
+  // penuh, lalu masuk lagi dari kanan). Boleh dipanggil saat scrolling.
+  void setScrollLoop(bool seamless, uint16_t gap = 16);
+  bool getScrollSeamless() const { return scrollSeamless; }
+  uint16_t getScrollGap() const { return scrollGap; }
+
+  // Ticker streaming untuk teks panjang/berkelanjutan: teks disimpan di
+  // ring buffer tetap (HUB12_TICKER_RING), bukan String. appendTicker()
+  // menambah item saat ticker jalan; item masuk dari kanan, getScrollGap()
+  // pixel setelah item sebelumnya. Glyph dirender hanya saat ada di
+  // window. Kecepatan dari setScrollRate(), update lewat updateScrolling(),
+  // stop lewat stopScrolling().
+  bool startTicker();
+  bool appendTicker(const char *text); // false = ring penuh / tidak aktif
+  bool isTickerActive() const { return tickerRing != nullptr; }
+  uint16_t getTickerFree() const {
+    return tickerRing ? HUB12_TICKER_RING - tickerCount : 0;
+  }
+
+  // Multi-zone: region bernama dengan konten dan interval update sendiri.
+  // updateZones() (di loop utama) hanya merender zone yang berubah dan
+  // sudah lewat intervalnya, lalu satu commit untuk semuanya. Font, ukuran
+  // dan warna zone diambil dari setting panel saat addZone(). Jangan
+  // dicampur dengan scroll/ticker layar penuh (keduanya menulis ke layar
+  // yang sama). Fungsi id < 0 (zone tidak ada) mengembalikan false.
+  int8_t addZone(const char *name, int16_t x, int16_t y, uint16_t w,
+                 uint16_t h); // id zone, -1 = penuh / rect / nama invalid
+  int8_t findZone(const char *name) const;
+  void removeZone(int8_t id);
+  void clearZones();
+  uint8_t getZoneCount() const;
+  // Teks lebih dari HUB12_ZONE_TEXT_LEN byte ditolak (false)
+  bool setZoneText(int8_t id, const char *text);
+  bool setZoneScroll(int8_t id, const char *text, uint16_t ppsQ8);
+  bool setZoneCounter(int8_t id, int32_t value);
+  bool addZoneCounter(int8_t id, int32_t delta); // saturasi di batas int32
+  int32_t getZoneCounter(int8_t id) const;
+  bool setZoneStyle(int8_t id, const GFXfont *font, uint8_t size,
+                    uint16_t color);
+  bool setZoneInterval(int8_t id, uint16_t ms);
+  void updateZones(); // call this di loop utama
   
   void swapBuffers(bool copyFrontToBack = false);
+
+  // Transaksi frame: beginFrame() ... commitFrame(). Selama transaksi
+  // helper teks (drawTextCentered, drawTextMultilineCentered) tidak swap
+  // sendiri dan setBrightness() baru berlaku saat commit, jadi satu update
+  // (clear + teks + brightness) = satu commit. Boleh nested, hanya commit
+  // terluar yang publish. swapBuffers() tetap langsung.
+  void beginFrame();
+  bool inFrame() const { return frameDepth != 0; }
+
+  // Seperti swapBuffers(), tapi frame baru baru dipakai ISR di awal scan
+  // frame berikutnya (tidak pernah tearing). Tidak menunggu; frame yang
+  // belum sempat tampil diganti oleh commit berikutnya.
+  void commitFrame(bool copyFrontToBack = true);
+  bool isFramePending() const { return wireReady != wireShown; }
+
+  // Transisi: pengganti commitFrame() (menutup transaksi yang sama), frame
+  // di back buffer masuk lewat efek selama `ms`, bukan cut. Tiap langkah
+  // updateTransition() hanya menyalin kolom/baris/pixel yang pindah dari
+  // back ke front dan mengonversi baris itu saja ke wire buffer. Jangan
+  // menggambar selama transisi: commit lain (swapBuffers, scroll, zone)
+  // langsung menyelesaikannya. false = masih di dalam transaksi luar.
+  bool commitTransition(uint8_t effect, uint16_t ms);
+  void updateTransition(); // call this di loop utama
+  bool isTransitionActive() const {
+    return transEffect != HUB12_TRANSITION_NONE;
+  }
+
+  // Vblank: frame counter dari scan ISR sebagai time base yang presisi
+  uint32_t getFrameCount() const;
+  uint32_t getFramePeriodUs() const;
+  void waitForVblank();
+
+protected:
+  // Teks GFXfont: glyph di-OR per byte ke back buffer (tiap plane BCM)
+  void drawGlyph(const uint8_t *bits, uint8_t w, uint8_t h, int16_t x,
+                 int16_t y, uint16_t c) override;
+
+  // Scan satu baris; ROW_BYTES = 0 berarti geometri runtime (wireRowBytes)
+  template <uint16_t ROW_BYTES> inline void scanWith();
+
+  // Byte strip mulai bit ke-s (m = 1 << s), sudah di-invert. Geser lintas
+  // byte lewat mul 8x8: low byte p[0] * m = p[0] << s, high byte p[1] * m =
+  // p[1] >> (8 - s), tanpa loop shift variabel di ISR.
+  static inline uint8_t stripByte(const uint8_t *p, uint8_t m) {
+    return ~((uint8_t)(p[0] * m) | (uint8_t)((p[1] * m) >> 8));
+  }
+
+  // Shift satu scan row dari strip: window mulai di kolom stripPos
+  inline void shiftStrip(uint16_t bytesPerRow) {
+    const uint8_t m = 1 << (stripPos & 7);
+    const uint8_t *r0 = stripShown + scanRow * stripStride + (stripPos >> 3);
+    const uint8_t *r4 = r0 + 4 * stripStride;
+    const uint8_t *r8 = r4 + 4 * stripStride;
+    const uint8_t *r12 = r8 + 4 * stripStride;
+    for (uint16_t i = 0; i < bytesPerRow; i++) {
+      HUB12_ShiftByte<PinR, PinCLK>::run(stripByte(r12 + i, m));
+      HUB12_ShiftByte<PinR, PinCLK>::run(stripByte(r8 + i, m));
+      HUB12_ShiftByte<PinR, PinCLK>::run(stripByte(r4 + i, m));
+      HUB12_ShiftByte<PinR, PinCLK>::run(stripByte(r0 + i, m));
+    }
+  }
+
+  // Bit dirty untuk baris y (tabel PROGMEM, hindari shift 16-bit per pixel)
+  static const uint16_t rowBits[16];
+  inline void markRowDirty(int16_t y) {
+    dirtyRows |= pgm_read_word(&rowBits[y & 0x0F]);
+  }
+  inline void markRowsDirty(int16_t y, int16_t h) {
+    for (; h > 0; h--, y++)
+      markRowDirty(y);
+  }
+
+  // Tulis satu pixel ke back buffer (index byte + mask sudah dihitung)
+  inline void plotPixel(uint16_t idx, uint8_t mask, int16_t y, uint16_t c) {
+    markRowDirty(y);
+    uint8_t *p = bufferBack + idx;
+    if (planes == 1) {
+      if (c)
+        *p |= mask;
+      else
+        *p &= ~mask;
+      return;
+    }
+    // Grayscale: bit n dari level masuk ke plane n
+    uint16_t level = (c > getMaxLevel()) ? getMaxLevel() : c;
+    for (uint8_t i = 0; i < planes; i++, p += bufferSize, level >>= 1) {
+      if (level & 1)
+        *p |= mask;
+      else
+        *p &= ~mask;
+    }
+  }
+
+private:
+  // Convert linear framebuffer ke urutan shift HUB12 (12->8->4->0, inverted)
+  // Hanya baris dengan bit di `rows` yang ditulis ulang
+  void buildWireBuffer(uint8_t *dst, const uint8_t *src, uint16_t rows);
+  // Paralel: interleave byte sub-chain (jarak seg byte) jadi field per clock
+  void packLines(uint8_t *d, const uint8_t *line, uint16_t seg);
+  // Copy baris bertanda di `rows` (semua plane) dari src ke dst
+  void copyRows(uint8_t *dst, const uint8_t *src, uint16_t rows);
+  // Wire buffer yang tidak dipakai ISR (tidak tampil dan tidak pending)
+  uint8_t freeWire();
+  // Serahkan wire[index] ke ISR; vsync = tunggu awal frame scan berikutnya
+  void publishWire(uint8_t index, bool vsync);
+  // Konversi baris `rows` dari src ke wire buffer bebas lalu publish
+  void publishRows(const uint8_t *src, uint16_t rows, bool vsync);
+  void present(bool copyFrontToBack, bool vsync);
+  // Transisi: pindahkan unit [from, to) dari back ke front, return baris
+  // front yang berubah
+  uint16_t stepTransition(uint16_t from, uint16_t to);
+  // Transisi: salin kolom [x0, x1) back -> front, return baris yang berubah
+  uint16_t copyColumns(int16_t x0, int16_t x1);
+  // Akhir helper gambar: swap kalau tidak sedang di dalam beginFrame()
+  void autoCommit();
+  // drawBitmap() ke tiap plane; opaque = bit 0 digambar dengan bg
+  void blitBitmap(const uint8_t *bmp, bool progmem, int16_t x, int16_t y,
+                  int16_t w, int16_t h, uint16_t c, uint16_t bg, bool opaque);
+  // Ukur scrollText dengan font sekarang (scrollW, scrollY)
+  void measureScroll();
+  // Panjang satu loop scroll render ulang (pixel)
+  uint16_t scrollPeriod() const;
+  // Panjang putaran pertama (scrollLead) untuk teks/period sekarang
+  uint16_t scrollLeadIn() const;
+  // Ticker: posisi vertikal + posisi ekor untuk font sekarang
+  void measureTicker();
+  // Advance dan batas kanan (opsional: kiri) ink glyph c relatif cursor
+  // (ticker, counter)
+  static void glyphMetrics(const GFXfont *font, uint8_t size, uint8_t c,
+                           int16_t &adv, int16_t &right,
+                           int16_t *left = nullptr);
+  // Ticker: geser px pixel, buang glyph yang lewat, gambar kolom yang masuk
+  void updateTicker(uint16_t px);
+  // Geser back buffer px kolom ke kiri (semua plane), kanan diisi 0
+  void shiftBackLeft(uint16_t px);
+  void freeTicker();
+  // Zone: id valid -> zone, selain itu null
+  HUB12_Zone *zoneAt(int8_t id) const;
+  // Zone: ukur teks scroll (textW, textY) dengan font zone
+  void measureZone(HUB12_Zone *z);
+  // Zone: render konten ke canvas lalu blit ke back buffer
+  void renderZone(HUB12_Zone *z);
+  // Zone counter: gambar ulang hanya sel digit yang berubah
+  bool renderCounter(HUB12_Zone *z); // false = tidak ada sel berubah
+  // Zone: blit kolom canvas [x0, x1) (dibulatkan ke byte) ke back buffer
+  void blitZone(HUB12_Zone *z, int16_t x0, int16_t x1);
+  // Print salinan scrollText tiap `period` pixel (salah satunya di kolom
+  // x) yang kena kolom [0, right) dari gfx. fromHead: hanya salinan di x
+  // dan sesudahnya (putaran pertama)
+  void printScrollCopies(Adafruit_GFX &gfx, int32_t x, uint16_t period,
+                         int16_t right, bool fromHead = false);
+  // Render scrollText sekali ke strip, false = render ulang tiap langkah
+  bool beginStripScroll();
+  void endStripScroll();
+  // Salin window strip mulai kolom offset ke back buffer
+  void blitStrip(uint16_t offset);
 };
 
+template <uint16_t ROW_BYTES> inline void HUB12_Panel::scanWith() {
+  if (!initialized)
+    return;
+
+  // Time-slicing: hanya slice terakhir yang latch + ganti alamat
+  const bool sliced = scanSlices > 1;
+  const bool latch = !sliced || scanSlice + 1 >= scanSlices;
+
+  // BCM: plane yang di-latch tick ini tampil (scanTicks << plane) tick
+  // Timer1 (dibagi rata ke semua slice). Ditulis di awal ISR supaya TCNT1
+  // belum melewati nilai baru.
+  if (planes > 1 && latch)
+    OCR1A = scanTicks << scanPlane;
+
+// 1. Turn off Output (Blanking)
+// Mode BCM / time-slicing tetap menyala selama shift (data lama masih di
+// latch) supaya waktu tampil tepat; blank hanya di sekitar latch + alamat.
+#if defined(__AVR_ATmega2560__)
+  uint8_t currentPWM = OCR3C;
+  if (planes == 1 && !sliced)
+    OCR3C = OE_ACTIVE_LOW ? 255 : 0;
+#endif
+
+  // Awal frame: ambil frame terbaru yang dipublish renderer (triple buffer)
+  // dan posisi scroll strip, supaya satu frame selalu konsisten
+  if (scanOffset == 0) {
+    if (wireReady != wireShown) {
+      wireShown = wireReady;
+      wireFront = wire[wireShown];
+    }
+    stripShown = stripNext;
+    stripPos = stripOffset;
+  }
+
+  // 2. Shift Data for 4 rows simultaneously (BEFORE setting address!)
+  // Wire buffer sudah dalam urutan shift (12 -> 8 -> 4 -> 0) dan sudah
+  // di-invert saat swapBuffers(), jadi ISR cukup jalan di pointer saja.
+  const uint8_t *p = wireFront + scanOffset;
+  const uint16_t n = (ROW_BYTES && !sliced) ? ROW_BYTES
+                     : latch                ? lastSliceBytes
+                                            : sliceBytes;
+  if (stripShown) {
+    shiftStrip(n / 4); // Scroll di ISR: mono, 1 line, tanpa slicing
+  } else
+#if HUB12_HAS_MSPIM
+  if (backend == HUB12_MSPIM) {
+    Mspim::shift(p, n); // Kembali setelah byte terakhir keluar (TXC)
+  } else
+#endif
+  if (ROW_BYTES && !sliced) {
+    HUB12_ShiftBytes<PinR, PinCLK, DATA_LINES, ROW_BYTES>::run(p);
+  } else {
+    const uint8_t *end = p + n;
+    while (p != end)
+      HUB12_ShiftByte<PinR, PinCLK, DATA_LINES>::run(*p++);
+  }
+  scanOffset += n;
+
+  if (!latch) {
+    scanSlice++;
+    return;
+  }
+  scanSlice = 0;
+
+#if defined(__AVR_ATmega2560__)
+  if (planes > 1 || sliced)
+    OCR3C = OE_ACTIVE_LOW ? 255 : 0;
+#endif
+
+  // 3. Latch (load shifted data into output latches)
+  PinLAT::pulse();
+
+  // 4. Select Row AFTER latch (prevents ghosting!)
+  // Old data was already latched, now safe to change address
+  PinA::write(scanRow & 0x01);
+  PinB::write(scanRow & 0x02);
+
+// 5. Restore Brightness
+#if defined(__AVR_ATmega2560__)
+  OCR3C = currentPWM;
+#endif
+
+  // Advance: plane 0..planes-1, lalu scan row berikutnya (0->1->2->3->0)
+  if (++scanPlane >= planes) {
+    scanPlane = 0;
+    scanRow = (scanRow + 1) & 0x03;
+    if (scanRow == 0) {
+      scanOffset = 0;
+      frameCount++;
+    }
+  }
+}
+
+/**
+ * HUB12 panel dengan geometri compile-time (contoh: HUB12_FixedPanel<32, 16, 2>
+ * untuk 64x16). Loop shift di ISR di-unroll penuh dan index drawPixel jadi
+ * konstanta/shift. Semua fitur lain sama dengan HUB12_Panel.
+ *
+ * Batasan: ini wrapper tipis di atas HUB12_Panel, bukan template geometri
+ * penuh. Hanya scan() dan drawPixel() yang memakai W/H/CHAIN konstan.
+ * fillRect, blit glyph, buildWireBuffer/publishRows dan scroll/strip tetap
+ * membaca config.width/totalWidthBytes saat runtime, dan objeknya membawa
+ * semua member HUB12_Panel (tidak lebih kecil dari versi runtime).
+ *
+ * ISR: tulis HUB12_FIXED_ISR(panel) sekali di sketch (scope global, setelah
+ * deklarasi panel). Vector Timer1 lalu memanggil scan() versi fixed secara
+ * langsung, tanpa pointer instance atau panggilan virtual. Lupa macro itu
+ * gagal saat link: begin() membaca hub12FixedIsr, yang hanya didefinisikan
+ * oleh HUB12_FIXED_ISR() ("undefined reference to `hub12FixedIsr'").
+ */
+extern const uint8_t hub12FixedIsr; // Definisi: HUB12_FIXED_ISR()
+
+template <uint16_t W, uint16_t H, uint16_t CHAIN>
+class HUB12_FixedPanel : public HUB12_Panel {
+  static const uint16_t BYTES_PER_ROW = (W * CHAIN) / 8;
+  static const uint16_t ROW_BYTES =
+      BYTES_PER_ROW / HUB12_DATA_LINES * 4 * LINE_BITS;
+
+  static_assert(CHAIN % HUB12_DATA_LINES == 0,
+                "CHAIN must split evenly across HUB12_DATA_LINES");
+  static_assert((W * CHAIN) % 8 == 0, "HUB12 width must be a multiple of 8");
+  static_assert(H <= 16, "HUB12 1/4 scan drives at most 16 rows");
+
+public:
+  HUB12_FixedPanel() : HUB12_Panel(W, H, CHAIN) {}
+
+  bool begin(int8_t r, int8_t clk, int8_t lat, int8_t oe, int8_t a,
+             int8_t b) {
+    // Dibaca (bukan konstanta) supaya referensinya tidak dibuang compiler
+    return hub12FixedIsr &&
+           HUB12_Panel::begin(r, clk, lat, oe, a, b, W, H, CHAIN);
+  }
+
+  // Menyembunyikan HUB12_Panel::scan(): dipanggil langsung dari
+  // HUB12_FIXED_ISR(), scanWith<> di-inline dengan ROW_BYTES konstan
+  inline void scan() { scanWith<ROW_BYTES>(); }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t c) override {
+    if ((uint16_t)x >= W * CHAIN || (uint16_t)y >= H)
+      return;
+    plotPixel(y * BYTES_PER_ROW + (x >> 3), 0x80 >> (x & 7), y, c);
+  }
+};
+
+// Vector Timer1 untuk satu HUB12_FixedPanel global (menggantikan ISR weak
+// di HUB12Panel.cpp). `panel` = nama objek, alamatnya konstanta link-time.
+// hub12FixedIsr menandai macro sudah dipakai (dicek HUB12_FixedPanel::begin())
+#define HUB12_FIXED_ISR(panel)                                                 \
+  extern const uint8_t hub12FixedIsr = 1;                                      \
+  ISR(TIMER1_COMPA_vect) { panel.scan(); }
+
 #endif
\ No newline at end of file
@@ -0,0 +1,326 @@
+#ifndef HUB_GLYPH_H
+#define HUB_GLYPH_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <avr/pgmspace.h>
+
+/**
+ * @file HUBGlyph.h
+ * @brief Byte-wise GFXfont text path shared by the HUB08/HUB12 panels
+ * @details Adafruit_GFX::drawChar() plots a custom-font glyph with one
+ *          virtual drawPixel() call (bounds check + index math) per set
+ *          bit. HUBGlyphGFX overrides write() instead: for size-1 GFXfont
+ *          text it reads each glyph row from PROGMEM and ORs it into the
+ *          panel's 1bpp buffer 8 pixels at a time, clipped per row.
+ *          The built-in 5x7 font and scaled text still go through
+ *          Adafruit_GFX unchanged.
+ *
+ *          A panel derives from HUBGlyphGFX instead of Adafruit_GFX and
+ *          implements drawGlyph(), usually by calling blitGlyph() on its
+ *          back buffer (row-major, MSB = leftmost pixel, 1 = on).
+ *
+ *          Text metrics take the same shortcut: getTextBounds() walks the
+ *          PROGMEM glyph table in one loop instead of one charBounds() call
+ *          per character, and lineHeight() is cached per font and size.
+ *
+ *          drawLinesCentered() is the multiline layout engine used by both
+ *          drivers. It works on `const char *` spans of the caller's text:
+ *          no String copies, no heap, no per-line arrays.
+ */
+
+/// Multiline layout rules (each driver keeps its own look)
+struct HUBTextLayout {
+  uint8_t maxLines;     ///< Lines past this are ignored
+  int8_t minLineHeight; ///< Font height is taken as at least this
+  int8_t lineGap;       ///< Line pitch = font height + lineGap
+  bool clampEdges;      ///< Never start above the top or left of the panel
+  bool alignBounds;     ///< Place each line by its own bounds top; false =
+                        ///< baseline at line top + font height
+};
+
+class HUBGlyphGFX : public Adafruit_GFX {
+public:
+  HUBGlyphGFX(int16_t w, int16_t h)
+      : Adafruit_GFX(w, h), heightFont(nullptr), heightSize(0),
+        heightWrap(false), heightCache(0) {}
+
+  /// Same cursor and wrap rules as Adafruit_GFX::write()
+  size_t write(uint8_t c) override;
+  using Print::write;
+
+  /// Same result as Adafruit_GFX::getTextBounds(), GFXfont measured in a
+  /// single loop (built-in font still goes through Adafruit_GFX)
+  using Adafruit_GFX::getTextBounds;
+  void getTextBounds(const char *str, int16_t x, int16_t y, int16_t *x1,
+                     int16_t *y1, uint16_t *w, uint16_t *h);
+  void getTextBounds(const String &str, int16_t x, int16_t y, int16_t *x1,
+                     int16_t *y1, uint16_t *w, uint16_t *h) {
+    getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+  }
+  /// getTextBounds() of the first `len` characters of `str`
+  void getSpanBounds(const char *str, uint16_t len, int16_t x, int16_t y,
+                     int16_t *x1, int16_t *y1, uint16_t *w, uint16_t *h);
+
+  /// Bounds height of "Ay" in the current font, recomputed only after the
+  /// font, text size or wrap setting changes
+  int16_t lineHeight();
+
+  /// Next non-empty '\n'-separated span at or after `p`, null when done
+  static const char *nextLine(const char *p, uint16_t *len);
+
+  /// Center every non-empty line of `text` (up to layout.maxLines) in the
+  /// back buffer at the current font. Returns the number of lines drawn.
+  uint8_t drawLinesCentered(const char *text, const HUBTextLayout &layout);
+
+protected:
+  /// Draw a glyph bitmap (PROGMEM bit stream, w x h, top-left at x,y)
+  virtual void drawGlyph(const uint8_t *bits, uint8_t w, uint8_t h,
+                         int16_t x, int16_t y, uint16_t color) = 0;
+
+  /// OR (on) or clear (!on) a glyph into a 1bpp buffer of bufW x bufH
+  /// pixels, `stride` bytes per row. Pixels outside the buffer are clipped.
+  static void blitGlyph(uint8_t *buf, uint16_t stride, int16_t bufW,
+                        int16_t bufH, const uint8_t *bits, uint8_t w,
+                        uint8_t h, int16_t x, int16_t y, bool on);
+
+private:
+  const GFXfont *heightFont; ///< Font/size/wrap lineHeight() was cached for
+  uint8_t heightSize;
+  bool heightWrap;
+  int16_t heightCache;
+};
+
+inline void HUBGlyphGFX::getTextBounds(const char *str, int16_t x, int16_t y,
+                                       int16_t *x1, int16_t *y1, uint16_t *w,
+                                       uint16_t *h) {
+  getSpanBounds(str, strlen(str), x, y, x1, y1, w, h);
+}
+
+inline void HUBGlyphGFX::getSpanBounds(const char *str, uint16_t len,
+                                       int16_t x, int16_t y, int16_t *x1,
+                                       int16_t *y1, uint16_t *w, uint16_t *h) {
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+
+  if (!gfxFont) {
+    // Built-in font: Adafruit_GFX rules as-is
+    while (len--)
+      charBounds(*str++, &x, &y, &minx, &miny, &maxx, &maxy);
+    if (maxx >= minx) {
+      *x1 = minx;
+      *w = maxx - minx + 1;
+    }
+    if (maxy >= miny) {
+      *y1 = miny;
+      *h = maxy - miny + 1;
+    }
+    return;
+  }
+
+  // Same rules as Adafruit_GFX::charBounds(), font header read once
+  const GFXglyph *glyphs = (const GFXglyph *)pgm_read_ptr(&gfxFont->glyph);
+  uint8_t first = pgm_read_byte(&gfxFont->first);
+  uint8_t last = pgm_read_byte(&gfxFont->last);
+  int16_t lineStep = textsize_y * (uint8_t)pgm_read_byte(&gfxFont->yAdvance);
+  int16_t tsx = textsize_x, tsy = textsize_y;
+
+  while (len--) {
+    uint8_t c = *str++;
+    if (c == '\n') {
+      x = 0;
+      y += lineStep;
+      continue;
+    }
+    if (c == '\r' || c < first || c > last)
+      continue;
+    const GFXglyph *glyph = glyphs + (c - first);
+    uint8_t gw = pgm_read_byte(&glyph->width);
+    uint8_t gh = pgm_read_byte(&glyph->height);
+    int8_t xo = pgm_read_byte(&glyph->xOffset);
+    int8_t yo = pgm_read_byte(&glyph->yOffset);
+    if (wrap && (x + ((int16_t)xo + gw) * tsx) > _width) {
+      x = 0;
+      y += lineStep;
+    }
+    int16_t gx1 = x + xo * tsx, gy1 = y + yo * tsy;
+    int16_t gx2 = gx1 + gw * tsx - 1, gy2 = gy1 + gh * tsy - 1;
+    if (gx1 < minx)
+      minx = gx1;
+    if (gy1 < miny)
+      miny = gy1;
+    if (gx2 > maxx)
+      maxx = gx2;
+    if (gy2 > maxy)
+      maxy = gy2;
+    x += (uint8_t)pgm_read_byte(&glyph->xAdvance) * tsx;
+  }
+
+  if (maxx >= minx) {
+    *x1 = minx;
+    *w = maxx - minx + 1;
+  }
+  if (maxy >= miny) {
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+inline int16_t HUBGlyphGFX::lineHeight() {
+  if (heightFont != gfxFont || heightSize != textsize_y || heightWrap != wrap ||
+      !heightCache) {
+    int16_t x1, y1;
+    uint16_t w, h;
+    getTextBounds("Ay", 0, 0, &x1, &y1, &w, &h);
+    heightFont = gfxFont;
+    heightSize = textsize_y;
+    heightWrap = wrap;
+    heightCache = h;
+  }
+  return heightCache;
+}
+
+inline const char *HUBGlyphGFX::nextLine(const char *p, uint16_t *len) {
+  while (*p == '\n')
+    p++;
+  if (!*p)
+    return nullptr;
+  const char *end = p;
+  while (*end && *end != '\n')
+    end++;
+  *len = end - p;
+  return p;
+}
+
+inline uint8_t HUBGlyphGFX::drawLinesCentered(const char *text,
+                                              const HUBTextLayout &layout) {
+  // Pass 1: count lines (text stays where it is, nothing copied)
+  uint8_t lineCount = 0;
+  uint16_t len;
+  for (const char *p = text; lineCount < layout.maxLines &&
+                             (p = nextLine(p, &len)) != nullptr;
+       p += len)
+    lineCount++;
+  if (lineCount == 0)
+    return 0;
+
+  int16_t fontHeight = lineHeight();
+  if (fontHeight < layout.minLineHeight)
+    fontHeight = layout.minLineHeight;
+  int16_t pitch = fontHeight + layout.lineGap;
+  int16_t top = (_height - ((lineCount - 1) * pitch + fontHeight)) / 2;
+  if (layout.clampEdges && top < 0)
+    top = 0;
+
+  // Pass 2: measure, center and print each span in place
+  const char *p = text;
+  for (uint8_t i = 0; i < lineCount; i++, p += len) {
+    p = nextLine(p, &len);
+    int16_t x1, y1;
+    uint16_t w, h;
+    getSpanBounds(p, len, 0, 0, &x1, &y1, &w, &h);
+    int16_t x = (_width - (int16_t)w) / 2;
+    if (layout.clampEdges && x < 0)
+      x = 0;
+    // alignBounds: bounds top of line i lands on top + i * pitch
+    int16_t y = layout.alignBounds ? top + i * pitch - y1
+                                   : top + fontHeight + i * pitch;
+    setCursor(x, y);
+    for (uint16_t k = 0; k < len; k++)
+      write((uint8_t)p[k]);
+  }
+  return lineCount;
+}
+
+inline size_t HUBGlyphGFX::write(uint8_t c) {
+  if (!gfxFont || textsize_x != 1 || textsize_y != 1)
+    return Adafruit_GFX::write(c);
+
+  uint8_t yAdvance = pgm_read_byte(&gfxFont->yAdvance);
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += yAdvance;
+    return 1;
+  }
+  uint16_t first = pgm_read_word(&gfxFont->first);
+  if (c == '\r' || c < first || c > pgm_read_word(&gfxFont->last))
+    return 1;
+
+  const GFXglyph *glyph =
+      (const GFXglyph *)pgm_read_ptr(&gfxFont->glyph) + (c - first);
+  uint8_t w = pgm_read_byte(&glyph->width);
+  uint8_t h = pgm_read_byte(&glyph->height);
+  if (w > 0 && h > 0) {
+    int8_t xo = pgm_read_byte(&glyph->xOffset);
+    int8_t yo = pgm_read_byte(&glyph->yOffset);
+    if (wrap && (cursor_x + xo + w) > _width) {
+      cursor_x = 0;
+      cursor_y += yAdvance;
+    }
+    const uint8_t *bits = (const uint8_t *)pgm_read_ptr(&gfxFont->bitmap) +
+                          pgm_read_word(&glyph->bitmapOffset);
+    drawGlyph(bits, w, h, cursor_x + xo, cursor_y + yo, textcolor);
+  }
+  cursor_x += (uint8_t)pgm_read_byte(&glyph->xAdvance);
+  return 1;
+}
+
+inline void HUBGlyphGFX::blitGlyph(uint8_t *buf, uint16_t stride,
+                                   int16_t bufW, int16_t bufH,
+                                   const uint8_t *bits, uint8_t w, uint8_t h,
+                                   int16_t x, int16_t y, bool on) {
+  // GFXfont bitmaps are one bit stream; glyph rows are not byte aligned
+  uint16_t bit = 0;
+  for (uint8_t row = 0; row < h; row++, y++, bit += w) {
+    if (y < 0)
+      continue;
+    if (y >= bufH)
+      break;
+    uint8_t *line = buf + y * stride;
+    for (uint8_t col = 0; col < w; col += 8) {
+      int16_t dx = x + col;
+      if (dx >= bufW)
+        break;
+      if (dx <= -8)
+        continue;
+
+      // Next 8 glyph pixels starting at stream bit (bit + col), MSB = left
+      uint16_t b = bit + col;
+      const uint8_t *p = bits + (b >> 3);
+      uint8_t s = b & 7;
+      uint8_t n = (w - col < 8) ? w - col : 8;
+      uint8_t chunk = pgm_read_byte(p) << s;
+      if (n > 8 - s)
+        chunk |= pgm_read_byte(p + 1) >> (8 - s);
+      chunk &= (uint8_t)(0xFF << (8 - n));
+
+      // Clip left/right edges for this row
+      if (dx < 0) {
+        chunk <<= -dx;
+        dx = 0;
+      }
+      if (dx + 8 > bufW)
+        chunk &= (uint8_t)(0xFF << (dx + 8 - bufW));
+      if (!chunk)
+        continue;
+
+      uint8_t *d = line + (dx >> 3);
+      uint8_t ds = dx & 7;
+      uint8_t hi = chunk >> ds;
+      uint8_t lo = ds ? (uint8_t)(chunk << (8 - ds)) : 0;
+      if (on) {
+        d[0] |= hi;
+        if (lo)
+          d[1] |= lo;
+      } else {
+        d[0] &= ~hi;
+        if (lo)
+          d[1] &= ~lo;
+      }
+    }
+  }
+}
+
+#endif
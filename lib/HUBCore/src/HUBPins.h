@@ -0,0 +1,192 @@
+#ifndef HUB_PINS_H
+#define HUB_PINS_H
+
+#include <Arduino.h>
+
+/**
+ * @file HUBPins.h
+ * @brief Compile-time pin traits for the HUB08/HUB12 scan ISRs
+ * @details Resolves an Arduino pin number to its AVR port register and bit
+ *          mask at compile time. Every access is an inline function with a
+ *          constant register and constant mask, so the compiler emits the
+ *          same code as hand-written `PORTx |= (1 << n)`: a single-cycle
+ *          `sbi/cbi` for ports in I/O space (PORTA..PORTG), `lds/ori/sts`
+ *          for the extended ports on the Mega (PORTH..PORTL).
+ *
+ *          Usage:
+ *          @code
+ *          typedef HUBPin<5> PinR;   // D5 -> PE3 on Mega, PD5 on Uno
+ *          PinR::output();
+ *          PinR::write(bit);
+ *          PinR::pulse();
+ *          @endcode
+ *
+ *          Using a pin that does not exist on the target MCU is a compile
+ *          error (HUBPin<N> has no definition).
+ */
+
+/// ========== Port access ==========
+/// One struct per AVR port. `id` is used to detect pins sharing a port.
+
+#define HUB_DEFINE_PORT(L)                                                    \
+  struct HUBPort##L {                                                        \
+    static const char id = #L[0];                                            \
+    static inline uint8_t read() { return PORT##L; }                         \
+    static inline void write(uint8_t v) { PORT##L = v; }                     \
+    static inline void set(uint8_t m) { PORT##L |= m; }                      \
+    static inline void clear(uint8_t m) { PORT##L &= (uint8_t)~m; }          \
+    static inline void output(uint8_t m) { DDR##L |= m; }                    \
+  };
+
+/// A single pin: port + constant bit
+template <class PORT, uint8_t BIT> struct HUBPinBits {
+  typedef PORT Port;
+  static const uint8_t bit = BIT;
+  static const uint8_t mask = (uint8_t)(1 << BIT);
+
+  static inline void high() { PORT::set(mask); }
+  static inline void low() { PORT::clear(mask); }
+  static inline void write(bool v) {
+    if (v)
+      high();
+    else
+      low();
+  }
+  static inline void pulse() {
+    high();
+    low();
+  }
+  static inline void output() { PORT::output(mask); }
+};
+
+/// Arduino pin number -> HUBPinBits (specialized per MCU below)
+template <uint8_t PIN> struct HUBPin;
+
+/// True when two pins live on the same port (one register write can set both)
+template <class A, class B> struct HUBSamePort {
+  static const bool value = (A::Port::id == B::Port::id);
+};
+
+#define HUB_PIN(N, L, B)                                                      \
+  template <> struct HUBPin<N> : HUBPinBits<HUBPort##L, B> {};
+
+#if defined(__AVR_ATmega2560__)
+// ========== Arduino Mega 2560 (variants/mega/pins_arduino.h) ==========
+HUB_DEFINE_PORT(A)
+HUB_DEFINE_PORT(B)
+HUB_DEFINE_PORT(C)
+HUB_DEFINE_PORT(D)
+HUB_DEFINE_PORT(E)
+HUB_DEFINE_PORT(F)
+HUB_DEFINE_PORT(G)
+HUB_DEFINE_PORT(H)
+HUB_DEFINE_PORT(J)
+HUB_DEFINE_PORT(K)
+HUB_DEFINE_PORT(L)
+
+HUB_PIN(0, E, 0)
+HUB_PIN(1, E, 1)
+HUB_PIN(2, E, 4)
+HUB_PIN(3, E, 5)
+HUB_PIN(4, G, 5)
+HUB_PIN(5, E, 3)
+HUB_PIN(6, H, 3)
+HUB_PIN(7, H, 4)
+HUB_PIN(8, H, 5)
+HUB_PIN(9, H, 6)
+HUB_PIN(10, B, 4)
+HUB_PIN(11, B, 5)
+HUB_PIN(12, B, 6)
+HUB_PIN(13, B, 7)
+HUB_PIN(14, J, 1)
+HUB_PIN(15, J, 0)
+HUB_PIN(16, H, 1)
+HUB_PIN(17, H, 0)
+HUB_PIN(18, D, 3)
+HUB_PIN(19, D, 2)
+HUB_PIN(20, D, 1)
+HUB_PIN(21, D, 0)
+HUB_PIN(22, A, 0)
+HUB_PIN(23, A, 1)
+HUB_PIN(24, A, 2)
+HUB_PIN(25, A, 3)
+HUB_PIN(26, A, 4)
+HUB_PIN(27, A, 5)
+HUB_PIN(28, A, 6)
+HUB_PIN(29, A, 7)
+HUB_PIN(30, C, 7)
+HUB_PIN(31, C, 6)
+HUB_PIN(32, C, 5)
+HUB_PIN(33, C, 4)
+HUB_PIN(34, C, 3)
+HUB_PIN(35, C, 2)
+HUB_PIN(36, C, 1)
+HUB_PIN(37, C, 0)
+HUB_PIN(38, D, 7)
+HUB_PIN(39, G, 2)
+HUB_PIN(40, G, 1)
+HUB_PIN(41, G, 0)
+HUB_PIN(42, L, 7)
+HUB_PIN(43, L, 6)
+HUB_PIN(44, L, 5)
+HUB_PIN(45, L, 4)
+HUB_PIN(46, L, 3)
+HUB_PIN(47, L, 2)
+HUB_PIN(48, L, 1)
+HUB_PIN(49, L, 0)
+HUB_PIN(50, B, 3)
+HUB_PIN(51, B, 2)
+HUB_PIN(52, B, 1)
+HUB_PIN(53, B, 0)
+HUB_PIN(54, F, 0) // A0
+HUB_PIN(55, F, 1)
+HUB_PIN(56, F, 2)
+HUB_PIN(57, F, 3)
+HUB_PIN(58, F, 4)
+HUB_PIN(59, F, 5)
+HUB_PIN(60, F, 6)
+HUB_PIN(61, F, 7)
+HUB_PIN(62, K, 0) // A8
+HUB_PIN(63, K, 1)
+HUB_PIN(64, K, 2)
+HUB_PIN(65, K, 3)
+HUB_PIN(66, K, 4)
+HUB_PIN(67, K, 5)
+HUB_PIN(68, K, 6)
+HUB_PIN(69, K, 7)
+
+#elif defined(__AVR_ATmega328P__)
+// ========== Arduino Uno / Nano / Pro Mini (variants/standard) ==========
+HUB_DEFINE_PORT(B)
+HUB_DEFINE_PORT(C)
+HUB_DEFINE_PORT(D)
+
+HUB_PIN(0, D, 0)
+HUB_PIN(1, D, 1)
+HUB_PIN(2, D, 2)
+HUB_PIN(3, D, 3)
+HUB_PIN(4, D, 4)
+HUB_PIN(5, D, 5)
+HUB_PIN(6, D, 6)
+HUB_PIN(7, D, 7)
+HUB_PIN(8, B, 0)
+HUB_PIN(9, B, 1)
+HUB_PIN(10, B, 2)
+HUB_PIN(11, B, 3)
+HUB_PIN(12, B, 4)
+HUB_PIN(13, B, 5)
+HUB_PIN(14, C, 0) // A0
+HUB_PIN(15, C, 1)
+HUB_PIN(16, C, 2)
+HUB_PIN(17, C, 3)
+HUB_PIN(18, C, 4)
+HUB_PIN(19, C, 5)
+
+#else
+#error "HUBPins.h: only ATmega2560 and ATmega328P are supported"
+#endif
+
+#undef HUB_PIN
+#undef HUB_DEFINE_PORT
+
+#endif
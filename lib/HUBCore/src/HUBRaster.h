@@ -0,0 +1,158 @@
+#ifndef HUB_RASTER_H
+#define HUB_RASTER_H
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+/**
+ * @file HUBRaster.h
+ * @brief Span fills and bitmap blits on the packed 1bpp panel buffers
+ * @details Row-major buffers, `stride` bytes per row, MSB = leftmost pixel,
+ *          1 = on (the HUB08 back buffer and each HUB12 BCM plane).
+ *          Adafruit_GFX draws lines, rects and bitmaps one virtual
+ *          drawPixel() per pixel; these routines touch each destination
+ *          byte once: masked read-modify-write for the partial bytes at
+ *          either end of a span, memset for the bytes in between.
+ *
+ *          Coordinates are clipped to the buffer; negative widths/heights
+ *          are normalized the same way GFXcanvas1 does.
+ */
+
+struct HUBRaster {
+  /// Normalize and clip a rect to bufW x bufH, false if nothing is left
+  static bool clip(int16_t &x, int16_t &y, int16_t &w, int16_t &h,
+                   int16_t bufW, int16_t bufH);
+
+  /// Set (on) or clear (!on) every pixel of the rect
+  static void fillRect(uint8_t *buf, uint16_t stride, int16_t bufW,
+                       int16_t bufH, int16_t x, int16_t y, int16_t w,
+                       int16_t h, bool on);
+
+  /// Adafruit-style bitmap, (w + 7) / 8 bytes per row, in PROGMEM or RAM.
+  /// Set bits become `fg`; clear bits become `bg` when `opaque`, otherwise
+  /// they are left untouched.
+  static void blitBitmap(uint8_t *buf, uint16_t stride, int16_t bufW,
+                         int16_t bufH, const uint8_t *bmp, bool progmem,
+                         int16_t x, int16_t y, int16_t w, int16_t h, bool fg,
+                         bool bg, bool opaque);
+};
+
+inline bool HUBRaster::clip(int16_t &x, int16_t &y, int16_t &w, int16_t &h,
+                            int16_t bufW, int16_t bufH) {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > bufW)
+    w = bufW - x;
+  if (y + h > bufH)
+    h = bufH - y;
+  return w > 0 && h > 0;
+}
+
+inline void HUBRaster::fillRect(uint8_t *buf, uint16_t stride, int16_t bufW,
+                                int16_t bufH, int16_t x, int16_t y, int16_t w,
+                                int16_t h, bool on) {
+  if (!clip(x, y, w, h, bufW, bufH))
+    return;
+
+  // First/last byte of the span and the pixels covered in each
+  int16_t x1 = x + w - 1;
+  uint16_t i0 = x >> 3, i1 = x1 >> 3;
+  uint8_t lm = 0xFF >> (x & 7);
+  uint8_t rm = 0xFF << (7 - (x1 & 7));
+  if (i0 == i1)
+    lm &= rm;
+
+  uint8_t *line = buf + y * stride;
+  for (; h > 0; h--, line += stride) {
+    if (on)
+      line[i0] |= lm;
+    else
+      line[i0] &= ~lm;
+    if (i0 == i1)
+      continue;
+    memset(line + i0 + 1, on ? 0xFF : 0x00, i1 - i0 - 1);
+    if (on)
+      line[i1] |= rm;
+    else
+      line[i1] &= ~rm;
+  }
+}
+
+inline void HUBRaster::blitBitmap(uint8_t *buf, uint16_t stride,
+                                  int16_t bufW, int16_t bufH,
+                                  const uint8_t *bmp, bool progmem, int16_t x,
+                                  int16_t y, int16_t w, int16_t h, bool fg,
+                                  bool bg, bool opaque) {
+  if (w <= 0 || h <= 0)
+    return;
+  // Opaque with fg == bg is just a solid rect
+  if (opaque && fg == bg) {
+    fillRect(buf, stride, bufW, bufH, x, y, w, h, fg);
+    return;
+  }
+
+  uint16_t bw = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++, bmp += bw) {
+    int16_t yy = y + j;
+    if (yy < 0)
+      continue;
+    if (yy >= bufH)
+      break;
+    uint8_t *line = buf + yy * stride;
+    for (uint16_t k = 0; k < bw; k++) {
+      int16_t dx = x + k * 8;
+      if (dx >= bufW)
+        break;
+      if (dx <= -8)
+        continue;
+
+      uint8_t v = progmem ? pgm_read_byte(bmp + k) : bmp[k];
+      uint8_t n = (w - k * 8 < 8) ? w - k * 8 : 8;
+      uint8_t m = 0xFF << (8 - n); // Valid bitmap pixels
+
+      // Clip left/right edges
+      if (dx < 0) {
+        v <<= -dx;
+        m <<= -dx;
+        dx = 0;
+      }
+      if (dx + 8 > bufW)
+        m &= (uint8_t)(0xFF << (dx + 8 - bufW));
+
+      // Bits to set and bits to clear in this buffer
+      uint8_t set, clr;
+      if (opaque) {
+        set = fg ? v : ~v;
+        clr = ~set;
+      } else {
+        set = fg ? v : 0;
+        clr = fg ? 0 : v;
+      }
+      set &= m;
+      clr &= m;
+
+      uint8_t *d = line + (dx >> 3);
+      uint8_t ds = dx & 7;
+      d[0] = (d[0] & ~(clr >> ds)) | (set >> ds);
+      if (ds && (uint8_t)(m << (8 - ds)))
+        d[1] = (d[1] & ~(uint8_t)(clr << (8 - ds))) |
+               (uint8_t)(set << (8 - ds));
+    }
+  }
+}
+
+#endif
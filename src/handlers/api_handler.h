@@ -10,6 +10,56 @@
 
 #include "HUB12Panel.h"
 
+// Allocator ArduinoJson dari buffer tetap (di stack pemanggil). Bump
+// allocator: blok terakhir dibesarkan/dikecilkan di tempat, blok lain
+// baru kembali saat pool hilang. Penuh -> nullptr, deserializeJson()
+// mengembalikan NoMemory.
+template <size_t N> class JsonFixedPool : public ArduinoJson::Allocator {
+public:
+  JsonFixedPool() : used(0), last(N) {}
+
+  void *allocate(size_t size) override {
+    size_t at = (used + HDR - 1) / HDR * HDR;
+    if (size > N || at + HDR + size > N)
+      return nullptr;
+    *(size_t *)(buf + at) = size;
+    last = at;
+    used = at + HDR + size;
+    return buf + at + HDR;
+  }
+
+  void deallocate(void *ptr) override {
+    if (ptr && ptr == buf + last + HDR) {
+      used = last;
+      last = N;
+    }
+  }
+
+  void *reallocate(void *ptr, size_t size) override {
+    if (!ptr)
+      return allocate(size);
+    uint8_t *p = (uint8_t *)ptr;
+    if (p == buf + last + HDR) {
+      if (size > N || last + HDR + size > N)
+        return nullptr;
+      *(size_t *)(buf + last) = size;
+      used = last + HDR + size;
+      return ptr;
+    }
+    size_t old = *(size_t *)(p - HDR);
+    void *q = allocate(size);
+    if (q)
+      memcpy(q, p, old < size ? old : size);
+    return q;
+  }
+
+private:
+  static const size_t HDR = sizeof(size_t); // Ukuran blok, juga alignment
+  size_t used;
+  size_t last; // Offset header blok terakhir, N = tidak ada
+  uint8_t buf[N] __attribute__((aligned(sizeof(size_t))));
+};
+
 class ApiHandler {
 private:
   EthernetServer server;
@@ -114,6 +164,18 @@ public:
     } else if (strcmp(method, "POST") == 0 &&
                strcmp(path, "/api/display/text") == 0) {
       handleDisplayText(client, contentLength);
+    } else if (strcmp(method, "POST") == 0 &&
+               strcmp(path, "/api/display/ticker/append") == 0) {
+      handleTickerAppend(client, contentLength);
+    } else if (strcmp(method, "POST") == 0 &&
+               strcmp(path, "/api/display/zone") == 0) {
+      handleDisplayZone(client, contentLength);
+    } else if (strcmp(method, "POST") == 0 &&
+               strcmp(path, "/api/display/zone/remove") == 0) {
+      handleDisplayZoneRemove(client, contentLength);
+    } else if (strcmp(method, "POST") == 0 &&
+               strcmp(path, "/api/display/counter") == 0) {
+      handleDisplayCounter(client, contentLength);
     } else if (strcmp(method, "POST") == 0 &&
                strcmp(path, "/api/display/clear") == 0) {
       handleDisplayClear(client);
@@ -143,6 +205,51 @@ private:
       ;
   }
 
+  // Baca body (maks MAX byte) ke buffer di stack lalu parse ke doc, yang
+  // memakai JsonFixedPool milik handler: body dan dokumen tidak menyentuh
+  // heap. false = response error sudah dikirim, handler cukup return.
+  template <size_t MAX>
+  bool readJsonBody(EthernetClient &client, int contentLength,
+                    JsonDocument &doc) {
+    if (contentLength <= 0 || contentLength > (int)MAX) {
+      client.println("HTTP/1.1 400 Bad Request");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"invalid content-length\"}");
+      return false;
+    }
+
+    char body[MAX + 1];
+    int read = 0;
+    unsigned long deadline = millis() + 1000;
+    while (read < contentLength && millis() < deadline) {
+      if (client.available()) {
+        body[read++] = client.read();
+      }
+    }
+    body[read] = '\0';
+
+    DeserializationError err = deserializeJson(doc, body);
+    if (err == DeserializationError::NoMemory) {
+      client.println("HTTP/1.1 413 Payload Too Large");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"json too large\"}");
+      return false;
+    }
+    if (err) {
+      client.println("HTTP/1.1 400 Bad Request");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"invalid json\"}");
+      return false;
+    }
+    return true;
+  }
+
   void handleDeviceInfo(EthernetClient &client) {
     // Build standard API response
     JsonDocument response;
@@ -174,7 +281,14 @@ private:
   //   "brightness":200,
   //   "scroll":false,          // optional: enable scrolling
   //   "scroll_speed":1,        // optional: 1-5 pixels per frame (default: 1)
-  //   "scroll_duration":5000   // optional: scrolling duration in ms (0=infinite)
+  //   "scroll_pps":12.5,       // optional: pixels per second (0.1-255),
+  //                            //           overrides scroll_speed
+  //   "scroll_gap":16,         // optional: seamless loop, px between the
+  //                            //           tail and the next head (0-255)
+  //   "scroll_duration":5000,  // optional: scrolling duration in ms (0=infinite)
+  //   "transition":"wipe",     // optional, static text only: wipe,
+  //                            //   slide_left, slide_up, curtain, dissolve
+  //   "transition_ms":500      // optional: transition length (50-10000)
   // }
   void handleDisplayText(EthernetClient &client, int contentLength) {
     if (!display) {
@@ -238,7 +352,34 @@ private:
 
     const char *text = doc["text"];
 
-    // Optional brightness
+    // Optional efek transisi (hanya teks diam), dicek sebelum layar disentuh
+    uint8_t effect = HUB12_TRANSITION_NONE;
+    if (doc["transition"].is<const char*>()) {
+      effect = parseTransition(doc["transition"].as<const char *>());
+      if (effect == 0xFF) {
+        client.println("HTTP/1.1 422 Unprocessable Entity");
+        client.println("Content-Type: application/json");
+        client.println("Connection: close");
+        client.println();
+        client.print("{\"error\":\"invalid transition\"}");
+        return;
+      }
+    }
+    uint16_t transitionMs = 500;
+    if (doc["transition_ms"].is<int>()) {
+      int ms = doc["transition_ms"];
+      if (ms < 50) ms = 50;
+      if (ms > 10000) ms = 10000;
+      transitionMs = ms;
+    }
+
+    // Satu transaksi frame: brightness + teks tampil bersama di satu commit
+    display->beginFrame();
+
+    // Teks layar penuh menggantikan layout zone
+    display->clearZones();
+
+    // Optional brightness (berlaku saat commitFrame)
     if (doc["brightness"].is<int>()) {
       int brightness = doc["brightness"];
       if (brightness < 0) brightness = 0;
@@ -264,9 +405,31 @@ private:
         scrollDuration = doc["scroll_duration"];
       }
       
+      // Loop seamless kalau scroll_gap ada, selain itu mode lama (teks
+      // keluar penuh dulu). Dikirim ke startScrolling() supaya strip hanya
+      // dirender sekali, langsung dengan period yang benar.
+      bool seamless = false;
+      int gap = 16;
+      if (doc["scroll_gap"].is<int>()) {
+        seamless = true;
+        gap = doc["scroll_gap"];
+        if (gap < 0) gap = 0;
+        if (gap > 255) gap = 255;
+      }
+
       // Start scrolling - akan terus loop di background (di loop utama)
       // scroll_duration hanya untuk API response, bukan untuk stop scrolling
-      display->startScrolling(text, scrollSpeed);
+      display->startScrolling(text, scrollSpeed, seamless, gap);
+
+      // Kecepatan halus dalam pixel/detik (Q8.8 di panel)
+      if (doc["scroll_pps"].is<float>()) {
+        float pps = doc["scroll_pps"];
+        if (pps < 0.1f) pps = 0.1f;
+        if (pps > 255.0f) pps = 255.0f;
+        display->setScrollRate((uint16_t)(pps * 256.0f));
+      }
+      uint16_t rate = display->getScrollRate();
+      display->commitFrame(true);
       
       // Send response IMMEDIATELY (don't block on scrolling)
       // Scrolling akan terus berjalan di loop utama dengan updateScrolling()
@@ -275,18 +438,26 @@ private:
       client.println("Connection: close");
       client.println();
       char response[256];
+      char loop[24];
+      if (display->getScrollSeamless())
+        snprintf(loop, sizeof(loop), "%u", display->getScrollGap());
+      else
+        strcpy(loop, "null");
       snprintf(response, sizeof(response),
-               "{\"ok\":true,\"message\":\"Scrolling started\",\"action\":\"scroll\",\"speed\":%u,\"info\":\"Scrolling runs in background - call /api/display/clear to stop\"}",
-               scrollSpeed);
+               "{\"ok\":true,\"message\":\"Scrolling started\",\"action\":\"scroll\",\"speed\":%u,\"pps\":%u.%u,\"gap\":%s,\"info\":\"Scrolling runs in background - call /api/display/clear to stop\"}",
+               scrollSpeed, rate >> 8, ((rate & 0xFF) * 10) >> 8, loop);
       client.print(response);
     } else {
       // Static text display (original behavior)
       // STOP scrolling jika ada yang aktif
       display->stopScrolling();
-      
-      display->fillScreen(0);
+
+      // Helper sudah clear back buffer; di dalam transaksi tidak swap
+      // sendiri, jadi hanya ada satu swap per request
       display->drawTextMultilineCentered(text);
-      display->swapBuffers(true);
+      // Transisi: frame lama -> teks baru lewat updateTransition() di loop
+      // utama; tanpa transisi commit biasa (cut)
+      display->commitTransition(effect, transitionMs);
 
       // Send response
       client.println("HTTP/1.1 200 OK");
@@ -298,6 +469,354 @@ private:
     }
   }
 
+  // Nama efek "transition" -> HUB12_Transition, 0xFF = tidak dikenal
+  static uint8_t parseTransition(const char *name) {
+    if (strcmp(name, "none") == 0) return HUB12_TRANSITION_NONE;
+    if (strcmp(name, "wipe") == 0) return HUB12_TRANSITION_WIPE;
+    if (strcmp(name, "slide_left") == 0) return HUB12_TRANSITION_SLIDE_LEFT;
+    if (strcmp(name, "slide_up") == 0) return HUB12_TRANSITION_SLIDE_UP;
+    if (strcmp(name, "curtain") == 0) return HUB12_TRANSITION_CURTAIN;
+    if (strcmp(name, "dissolve") == 0) return HUB12_TRANSITION_DISSOLVE;
+    return 0xFF;
+  }
+
+  // POST /api/display/ticker/append - Add an item to the streaming ticker
+  // Body: {
+  //   "text":"USD/IDR 15.720",
+  //   "scroll_pps":20,         // optional: pixels per second (0.1-255)
+  //   "scroll_gap":24          // optional: px between items (0-255)
+  // }
+  // Starts the ticker if it is not running. Items queue in the panel's
+  // fixed ring buffer, so the running ticker is never restarted.
+  void handleTickerAppend(EthernetClient &client, int contentLength) {
+    if (!display) {
+      client.println("HTTP/1.1 503 Service Unavailable");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"display service not available\"}");
+      return;
+    }
+
+    JsonFixedPool<1024> pool;
+    JsonDocument doc(&pool);
+    if (!readJsonBody<512>(client, contentLength, doc))
+      return;
+
+    if (!doc["text"].is<const char*>()) {
+      client.println("HTTP/1.1 422 Unprocessable Entity");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"missing required field: text\"}");
+      return;
+    }
+
+    // Ticker layar penuh menggantikan layout zone
+    if (!display->isTickerActive()) {
+      display->clearZones();
+      if (!display->startTicker()) {
+        client.println("HTTP/1.1 500 Internal Server Error");
+        client.println("Content-Type: application/json");
+        client.println("Connection: close");
+        client.println();
+        client.print("{\"error\":\"out of memory\"}");
+        return;
+      }
+    }
+
+    if (doc["scroll_pps"].is<float>()) {
+      float pps = doc["scroll_pps"];
+      if (pps < 0.1f) pps = 0.1f;
+      if (pps > 255.0f) pps = 255.0f;
+      display->setScrollRate((uint16_t)(pps * 256.0f));
+    }
+    if (doc["scroll_gap"].is<int>()) {
+      int gap = doc["scroll_gap"];
+      if (gap < 0) gap = 0;
+      if (gap > 255) gap = 255;
+      display->setScrollLoop(true, gap);
+    }
+
+    // Ring penuh: item ditolak utuh, ticker tetap jalan
+    if (!display->appendTicker(doc["text"].as<const char *>())) {
+      client.println("HTTP/1.1 507 Insufficient Storage");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      char response[64];
+      snprintf(response, sizeof(response),
+               "{\"error\":\"ticker buffer full\",\"free\":%u}",
+               display->getTickerFree());
+      client.print(response);
+      return;
+    }
+
+    client.println("HTTP/1.1 200 OK");
+    client.println("Content-Type: application/json");
+    client.println("Connection: close");
+    client.println();
+    char response[96];
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"message\":\"Item queued\",\"action\":\"ticker\",\"free\":%u}",
+             display->getTickerFree());
+    client.print(response);
+  }
+
+  // POST /api/display/zone - Create or update a named zone
+  // Body: {
+  //   "name":"clock",          // required, max 8 chars
+  //   "x":0,"y":0,"w":24,"h":16, // required to create, optional to update
+  //   "text":"12:30",          // static text, or with "scroll":true a
+  //   "scroll":false,          //   running text inside the zone
+  //   "scroll_pps":20,         // optional: scroll speed (0.1-255 px/s)
+  //   "counter":42,            // number (instead of text)
+  //   "interval":1000          // optional: min ms between redraws
+  // }
+  void handleDisplayZone(EthernetClient &client, int contentLength) {
+    if (!display) {
+      client.println("HTTP/1.1 503 Service Unavailable");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"display service not available\"}");
+      return;
+    }
+
+    JsonFixedPool<1024> pool;
+    JsonDocument doc(&pool);
+    if (!readJsonBody<512>(client, contentLength, doc))
+      return;
+
+    const char *name = doc["name"];
+    if (!name) {
+      client.println("HTTP/1.1 422 Unprocessable Entity");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"missing required field: name\"}");
+      return;
+    }
+
+    // Teks disimpan di array tetap per zone (HUB12_ZONE_TEXT_LEN)
+    if (doc["text"].is<const char*>() &&
+        strlen(doc["text"].as<const char *>()) > HUB12_ZONE_TEXT_LEN) {
+      client.println("HTTP/1.1 422 Unprocessable Entity");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"text too long\"}");
+      return;
+    }
+
+    // Rect baru (atau zone belum ada): buat / ganti zone. Divalidasi dan
+    // dibuat dulu, tampilan sekarang tidak disentuh kalau gagal.
+    bool first = display->getZoneCount() == 0;
+    int8_t id = display->findZone(name);
+    if (doc["w"].is<int>() || id < 0) {
+      if (!doc["x"].is<int>() || !doc["y"].is<int>() || !doc["w"].is<int>() ||
+          !doc["h"].is<int>()) {
+        client.println("HTTP/1.1 422 Unprocessable Entity");
+        client.println("Content-Type: application/json");
+        client.println("Connection: close");
+        client.println();
+        client.print("{\"error\":\"missing required field: x, y, w, h\"}");
+        return;
+      }
+      id = display->addZone(name, doc["x"].as<int>(), doc["y"].as<int>(),
+                            doc["w"].as<int>(), doc["h"].as<int>());
+      if (id < 0) {
+        client.println("HTTP/1.1 422 Unprocessable Entity");
+        client.println("Content-Type: application/json");
+        client.println("Connection: close");
+        client.println();
+        client.print(
+            "{\"error\":\"invalid zone (name, rect off screen or zone limit)\"}");
+        return;
+      }
+    }
+
+    // Zone pertama: layar penuh (teks/scroll/ticker) diganti layout zone.
+    // Layar kosong langsung di-commit, zone muncul di updateZones().
+    if (first) {
+      display->beginFrame();
+      display->stopScrolling();
+      display->clearScreen();
+      display->commitFrame(true);
+    }
+
+    if (doc["interval"].is<int>()) {
+      int interval = doc["interval"];
+      if (interval < 0) interval = 0;
+      if (interval > 60000) interval = 60000;
+      display->setZoneInterval(id, interval);
+    }
+
+    if (doc["counter"].is<long>()) {
+      display->setZoneCounter(id, doc["counter"].as<long>());
+    } else if (doc["text"].is<const char*>()) {
+      const char *text = doc["text"];
+      if (doc["scroll"].is<bool>() && doc["scroll"].as<bool>()) {
+        uint16_t rate = 25 << 8;
+        if (doc["scroll_pps"].is<float>()) {
+          float pps = doc["scroll_pps"];
+          if (pps < 0.1f) pps = 0.1f;
+          if (pps > 255.0f) pps = 255.0f;
+          rate = (uint16_t)(pps * 256.0f);
+        }
+        display->setZoneScroll(id, text, rate);
+      } else {
+        display->setZoneText(id, text);
+      }
+    }
+
+    // Render lewat updateZones() di loop utama, hanya zone yang berubah
+    client.println("HTTP/1.1 200 OK");
+    client.println("Content-Type: application/json");
+    client.println("Connection: close");
+    client.println();
+    char response[96];
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"message\":\"Zone updated\",\"action\":\"zone\",\"zones\":%u}",
+             display->getZoneCount());
+    client.print(response);
+  }
+
+  // POST /api/display/zone/remove - Remove a named zone
+  // Body: {"name":"clock"}
+  void handleDisplayZoneRemove(EthernetClient &client, int contentLength) {
+    if (!display) {
+      client.println("HTTP/1.1 503 Service Unavailable");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"display service not available\"}");
+      return;
+    }
+
+    JsonFixedPool<256> pool;
+    JsonDocument doc(&pool);
+    if (!readJsonBody<128>(client, contentLength, doc))
+      return;
+
+    int8_t id = doc["name"].is<const char*>()
+                    ? display->findZone(doc["name"].as<const char *>())
+                    : -1;
+    if (id < 0) {
+      client.println("HTTP/1.1 404 Not Found");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"zone not found\"}");
+      return;
+    }
+    display->removeZone(id);
+
+    client.println("HTTP/1.1 200 OK");
+    client.println("Content-Type: application/json");
+    client.println("Connection: close");
+    client.println();
+    char response[96];
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"message\":\"Zone removed\",\"action\":\"zone\",\"zones\":%u}",
+             display->getZoneCount());
+    client.print(response);
+  }
+
+  // POST /api/display/counter - Counter mode (nomor antrian / hitungan produksi)
+  // Body: {"value":42} set, {"add":1} / {"add":-1} naik/turun atomik di
+  // device, optional "name" (zone counter, default "counter"). Zone belum
+  // ada: dibuat layar penuh. Hanya digit yang berubah digambar ulang.
+  void handleDisplayCounter(EthernetClient &client, int contentLength) {
+    if (!display) {
+      client.println("HTTP/1.1 503 Service Unavailable");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"display service not available\"}");
+      return;
+    }
+
+    // Body kecil: update counter tidak menyentuh heap
+    JsonFixedPool<256> pool;
+    JsonDocument doc(&pool);
+    if (!readJsonBody<95>(client, contentLength, doc))
+      return;
+
+    bool hasValue = doc["value"].is<long>();
+    bool hasAdd = doc["add"].is<long>();
+    if (!hasValue && !hasAdd) {
+      client.println("HTTP/1.1 422 Unprocessable Entity");
+      client.println("Content-Type: application/json");
+      client.println("Connection: close");
+      client.println();
+      client.print("{\"error\":\"missing required field: value or add\"}");
+      return;
+    }
+
+    const char *name = doc["name"].is<const char*>()
+                           ? doc["name"].as<const char *>()
+                           : "counter";
+    int8_t id = display->findZone(name);
+    if (id < 0) {
+      // Nama dicek dulu, tampilan sekarang tidak disentuh kalau invalid
+      if (!*name || strlen(name) > HUB12_ZONE_NAME_LEN) {
+        client.println("HTTP/1.1 422 Unprocessable Entity");
+        client.println("Content-Type: application/json");
+        client.println("Connection: close");
+        client.println();
+        client.print("{\"error\":\"invalid zone name\"}");
+        return;
+      }
+      if (display->getZoneCount() >= HUB12_MAX_ZONES) {
+        client.println("HTTP/1.1 422 Unprocessable Entity");
+        client.println("Content-Type: application/json");
+        client.println("Connection: close");
+        client.println();
+        client.print("{\"error\":\"zone limit reached\"}");
+        return;
+      }
+      // Counter baru: zone layar penuh dibuat dulu, tampilan sekarang
+      // tidak disentuh kalau alokasi gagal
+      id = display->addZone(name, 0, 0, display->width(), display->height());
+      if (id < 0) {
+        client.println("HTTP/1.1 500 Internal Server Error");
+        client.println("Content-Type: application/json");
+        client.println("Connection: close");
+        client.println();
+        client.print("{\"error\":\"out of memory\"}");
+        return;
+      }
+      // Baru setelah berhasil: zone lain dan teks/scroll diganti counter,
+      // layar kosong di-commit dalam satu frame
+      display->beginFrame();
+      display->stopScrolling();
+      for (int8_t i = 0; i < HUB12_MAX_ZONES; i++)
+        if (i != id)
+          display->removeZone(i);
+      display->clearScreen();
+      display->commitFrame(true);
+      display->setZoneCounter(id, 0);
+    }
+
+    if (hasValue)
+      display->setZoneCounter(id, doc["value"].as<long>());
+    if (hasAdd)
+      display->addZoneCounter(id, doc["add"].as<long>());
+
+    // Render lewat updateZones() di loop utama; update yang datang lebih
+    // cepat dari loop digabung jadi satu frame
+    client.println("HTTP/1.1 200 OK");
+    client.println("Content-Type: application/json");
+    client.println("Connection: close");
+    client.println();
+    char response[64];
+    snprintf(response, sizeof(response),
+             "{\"ok\":true,\"action\":\"counter\",\"value\":%ld}",
+             (long)display->getZoneCounter(id));
+    client.print(response);
+  }
+
   // POST /api/display/clear - Clear display
   void handleDisplayClear(EthernetClient &client) {
     if (!display) {
@@ -309,8 +828,11 @@ private:
       return;
     }
 
-    display->fillScreen(0);
-    display->swapBuffers(true);
+    display->beginFrame();
+    display->stopScrolling();
+    display->clearZones();
+    display->clearScreen();
+    display->commitFrame(true);
 
     client.println("HTTP/1.1 200 OK");
     client.println("Content-Type: application/json");
@@ -32,7 +32,10 @@ bool lanWasConnected = false;
 
 // --- Global Objects ---
 // Lebar 32, Tinggi 16, Chain 2 (Total 64x16)
-HUB12_Panel display(32, 16, 2);
+// Geometri compile-time: loop shift di ISR di-unroll penuh
+HUB12_FixedPanel<32, 16, 2> display;
+// Timer1 ISR langsung ke scan() fixed di atas (tanpa panggilan virtual)
+HUB12_FIXED_ISR(display)
 ApiHandler apiHandler;
 
 bool initEthernet() {
@@ -48,7 +51,6 @@ bool initEthernet() {
   Serial.println();
 
   // Tampilkan status di LED
-  display.fillScreen(0);
   display.drawTextMultilineCentered("LAN INIT.");
 
   // Reset W5100 dengan toggle CS pin
@@ -87,7 +89,6 @@ bool initEthernet() {
     Serial.println(
         "Check: 1) Shield mounted? 2) Pin 53 as OUTPUT? 3) SPI pins free?");
     Serial.println("       4) Try manual reset button on Arduino");
-    display.fillScreen(0);
     display.drawTextMultilineCentered("ERR: LAN.");
     return false;
   case EthernetW5100:
@@ -130,7 +131,6 @@ bool initEthernet() {
   Serial.println("Mode: Static IP (ready immediately)");
   Serial.println("--- Configuration OK ---\n");
 
-  display.fillScreen(0);
   display.drawTextMultilineCentered("NET OK");
   delay(500);
 
@@ -154,7 +154,6 @@ void checkLanConnection() {
     }
   } else if (!isConnected && lanWasConnected) {
     Serial.println("LAN: Link DOWN.");
-    display.fillScreen(0);
     display.drawTextMultilineCentered("LAN DOWN.");
     // Let maintain run but don't spam; controller will try to re-init when link
     // returns
@@ -216,8 +215,10 @@ void setup() {
 
   // 2. Init Display (HUB12 P10)
   Serial.print("Init Display ");
-  // Parameter: R=5, CLK=7, LAT=8, OE=3, A=A0, B=A1, W=32, H=16, Chain=2
-  if (display.begin(5, 7, 8, 3, A0, A1, 32, 16, 2)) {
+  // Triple buffer: publish frame tanpa cli(), +1 wire buffer (128 byte)
+  display.setTripleBuffering(true);
+  // Parameter: R=5, CLK=7, LAT=8, OE=3, A=A0, B=A1 (32x16, Chain=2 dari tipe)
+  if (display.begin(5, 7, 8, 3, A0, A1)) {
     Serial.println("OK");
 
     display.setBrightness(10);
@@ -250,8 +251,6 @@ void setup() {
   apiHandler.setDisplay(&display);
 
   Serial.println("System Ready.");
-  display.fillScreen(0);
-
   display.drawTextMultilineCentered("READY.");
 }
 
@@ -271,6 +270,10 @@ void loop() {
   // Update scrolling setiap frame (jika scrolling aktif)
   // Ini memungkinkan scrolling terus berjalan di background
   display.updateScrolling();
+  // Zone (jika ada layout zone): hanya zone yang berubah yang dirender
+  display.updateZones();
+  // Transisi teks (jika ada): langkah berikutnya dari waktu
+  display.updateTransition();
 
   delay(10);
 }
\ No newline at end of file
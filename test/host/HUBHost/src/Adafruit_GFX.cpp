@@ -0,0 +1,319 @@
+#include "Adafruit_GFX.h"
+
+// Drawing rules follow Adafruit_GFX.cpp (1.12); see Adafruit_GFX.h
+
+static void swapInt16(int16_t &a, int16_t &b) {
+  int16_t t = a;
+  a = b;
+  b = t;
+}
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) : WIDTH(w), HEIGHT(h) {
+  _width = WIDTH;
+  _height = HEIGHT;
+  rotation = 0;
+  cursor_y = cursor_x = 0;
+  textsize_x = textsize_y = 1;
+  textcolor = textbgcolor = 0xFFFF;
+  wrap = true;
+  _cp437 = false;
+  gfxFont = NULL;
+}
+
+void Adafruit_GFX::writeLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                             uint16_t color) {
+  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    swapInt16(x0, y0);
+    swapInt16(x1, y1);
+  }
+  if (x0 > x1) {
+    swapInt16(x0, x1);
+    swapInt16(y0, y1);
+  }
+  int16_t dx = x1 - x0, dy = abs(y1 - y0);
+  int16_t err = dx / 2, ystep = (y0 < y1) ? 1 : -1;
+  for (; x0 <= x1; x0++) {
+    if (steep)
+      writePixel(y0, x0, color);
+    else
+      writePixel(x0, y0, color);
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+void Adafruit_GFX::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                            uint16_t color) {
+  startWrite();
+  for (int16_t i = x; i < x + w; i++)
+    writeFastVLine(i, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+                            uint16_t color) {
+  startWrite();
+  writeFastHLine(x, y, w, color);
+  writeFastHLine(x, y + h - 1, w, color);
+  writeFastVLine(x, y, h, color);
+  writeFastVLine(x + w - 1, y, h, color);
+  endWrite();
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color) {
+  int16_t byteWidth = (w + 7) / 8;
+  uint8_t b = 0;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b <<= 1;
+      else
+        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      if (b & 0x80)
+        writePixel(x + i, y, color);
+    }
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[],
+                              int16_t w, int16_t h, uint16_t color,
+                              uint16_t bg) {
+  int16_t byteWidth = (w + 7) / 8;
+  uint8_t b = 0;
+  startWrite();
+  for (int16_t j = 0; j < h; j++, y++) {
+    for (int16_t i = 0; i < w; i++) {
+      if (i & 7)
+        b <<= 1;
+      else
+        b = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+      writePixel(x + i, y, (b & 0x80) ? color : bg);
+    }
+  }
+  endWrite();
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                              int16_t h, uint16_t color) {
+  drawBitmap(x, y, (const uint8_t *)bitmap, w, h, color);
+}
+
+void Adafruit_GFX::drawBitmap(int16_t x, int16_t y, uint8_t *bitmap, int16_t w,
+                              int16_t h, uint16_t color, uint16_t bg) {
+  drawBitmap(x, y, (const uint8_t *)bitmap, w, h, color, bg);
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c,
+                            uint16_t color, uint16_t bg, uint8_t size_x,
+                            uint8_t size_y) {
+  if (!gfxFont) {
+    // Built-in font stand-in: 5x7 pattern derived from c, 6x8 cell
+    startWrite();
+    for (int8_t i = 0; i < 5; i++) {
+      for (int8_t j = 0; j < 7; j++) {
+        bool on = (c * (i + 3) + j) & 2;
+        if (on || bg != color)
+          writeFillRect(x + i * size_x, y + j * size_y, size_x, size_y,
+                        on ? color : bg);
+      }
+    }
+    endWrite();
+    return;
+  }
+
+  c -= (uint8_t)pgm_read_byte(&gfxFont->first);
+  const GFXglyph *glyph = gfxFont->glyph + c;
+  const uint8_t *bitmap = gfxFont->bitmap;
+  uint16_t bo = glyph->bitmapOffset;
+  uint8_t w = glyph->width, h = glyph->height;
+  int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+  uint8_t bits = 0, bit = 0;
+  int16_t xo16 = xo, yo16 = yo;
+
+  startWrite();
+  for (uint8_t yy = 0; yy < h; yy++) {
+    for (uint8_t xx = 0; xx < w; xx++) {
+      if (!(bit++ & 7))
+        bits = pgm_read_byte(&bitmap[bo++]);
+      if (bits & 0x80) {
+        if (size_x == 1 && size_y == 1)
+          writePixel(x + xo + xx, y + yo + yy, color);
+        else
+          writeFillRect(x + (xo16 + xx) * size_x, y + (yo16 + yy) * size_y,
+                        size_x, size_y, color);
+      }
+      bits <<= 1;
+    }
+  }
+  endWrite();
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+  if (!gfxFont) {
+    if (c == '\n') {
+      cursor_x = 0;
+      cursor_y += textsize_y * 8;
+    } else if (c != '\r') {
+      if (wrap && ((cursor_x + textsize_x * 6) > _width)) {
+        cursor_x = 0;
+        cursor_y += textsize_y * 8;
+      }
+      drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
+               textsize_y);
+      cursor_x += textsize_x * 6;
+    }
+    return 1;
+  }
+
+  if (c == '\n') {
+    cursor_x = 0;
+    cursor_y += (int16_t)textsize_y * (uint8_t)gfxFont->yAdvance;
+  } else if (c != '\r') {
+    uint8_t first = gfxFont->first;
+    if ((c >= first) && (c <= (uint8_t)gfxFont->last)) {
+      const GFXglyph *glyph = gfxFont->glyph + (c - first);
+      uint8_t w = glyph->width, h = glyph->height;
+      if ((w > 0) && (h > 0)) {
+        int16_t xo = (int8_t)glyph->xOffset;
+        if (wrap && ((cursor_x + textsize_x * (xo + w)) > _width)) {
+          cursor_x = 0;
+          cursor_y += (int16_t)textsize_y * (uint8_t)gfxFont->yAdvance;
+        }
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x,
+                 textsize_y);
+      }
+      cursor_x += (uint8_t)glyph->xAdvance * (int16_t)textsize_x;
+    }
+  }
+  return 1;
+}
+
+void Adafruit_GFX::setFont(const GFXfont *f) {
+  if (f) {
+    if (!gfxFont)
+      cursor_y += 6; // Classic font origin is top-left, GFXfont baseline
+  } else if (gfxFont) {
+    cursor_y -= 6;
+  }
+  gfxFont = (GFXfont *)f;
+}
+
+void Adafruit_GFX::charBounds(unsigned char c, int16_t *x, int16_t *y,
+                              int16_t *minx, int16_t *miny, int16_t *maxx,
+                              int16_t *maxy) {
+  if (gfxFont) {
+    if (c == '\n') {
+      *x = 0;
+      *y += textsize_y * (uint8_t)gfxFont->yAdvance;
+    } else if (c != '\r') {
+      uint8_t first = gfxFont->first, last = gfxFont->last;
+      if ((c >= first) && (c <= last)) {
+        const GFXglyph *glyph = gfxFont->glyph + (c - first);
+        uint8_t gw = glyph->width, gh = glyph->height,
+                xa = glyph->xAdvance;
+        int8_t xo = glyph->xOffset, yo = glyph->yOffset;
+        if (wrap && ((*x + (((int16_t)xo + gw) * textsize_x)) > _width)) {
+          *x = 0;
+          *y += textsize_y * (uint8_t)gfxFont->yAdvance;
+        }
+        int16_t tsx = (int16_t)textsize_x, tsy = (int16_t)textsize_y;
+        int16_t x1 = *x + xo * tsx, y1 = *y + yo * tsy;
+        int16_t x2 = x1 + gw * tsx - 1, y2 = y1 + gh * tsy - 1;
+        if (x1 < *minx)
+          *minx = x1;
+        if (y1 < *miny)
+          *miny = y1;
+        if (x2 > *maxx)
+          *maxx = x2;
+        if (y2 > *maxy)
+          *maxy = y2;
+        *x += xa * tsx;
+      }
+    }
+    return;
+  }
+
+  if (c == '\n') {
+    *x = 0;
+    *y += textsize_y * 8;
+  } else if (c != '\r') {
+    if (wrap && ((*x + textsize_x * 6) > _width)) {
+      *x = 0;
+      *y += textsize_y * 8;
+    }
+    int x2 = *x + textsize_x * 6 - 1, y2 = *y + textsize_y * 8 - 1;
+    if (x2 > *maxx)
+      *maxx = x2;
+    if (y2 > *maxy)
+      *maxy = y2;
+    if (*x < *minx)
+      *minx = *x;
+    if (*y < *miny)
+      *miny = *y;
+    *x += textsize_x * 6;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const char *str, int16_t x, int16_t y,
+                                 int16_t *x1, int16_t *y1, uint16_t *w,
+                                 uint16_t *h) {
+  uint8_t c;
+  int16_t minx = 0x7FFF, miny = 0x7FFF, maxx = -1, maxy = -1;
+  *x1 = x;
+  *y1 = y;
+  *w = *h = 0;
+  while ((c = *str++))
+    charBounds(c, &x, &y, &minx, &miny, &maxx, &maxy);
+  if (maxx >= minx) {
+    *x1 = minx;
+    *w = maxx - minx + 1;
+  }
+  if (maxy >= miny) {
+    *y1 = miny;
+    *h = maxy - miny + 1;
+  }
+}
+
+void Adafruit_GFX::getTextBounds(const String &str, int16_t x, int16_t y,
+                                 int16_t *x1, int16_t *y1, uint16_t *w,
+                                 uint16_t *h) {
+  if (str.length() != 0)
+    getTextBounds(str.c_str(), x, y, x1, y1, w, h);
+}
+
+GFXcanvas1::GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h) {
+  uint32_t bytes = ((w + 7) / 8) * h;
+  buffer = (uint8_t *)malloc(bytes);
+  if (buffer)
+    memset(buffer, 0, bytes);
+}
+
+GFXcanvas1::~GFXcanvas1(void) { free(buffer); }
+
+void GFXcanvas1::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height)
+    return;
+  uint8_t *p = &buffer[(x / 8) + y * ((WIDTH + 7) / 8)];
+  if (color)
+    *p |= 0x80 >> (x & 7);
+  else
+    *p &= ~(0x80 >> (x & 7));
+}
+
+void GFXcanvas1::fillScreen(uint16_t color) {
+  if (buffer)
+    memset(buffer, color ? 0xFF : 0x00, ((WIDTH + 7) / 8) * HEIGHT);
+}
+
+bool GFXcanvas1::getPixel(int16_t x, int16_t y) const {
+  if (!buffer || x < 0 || y < 0 || x >= _width || y >= _height)
+    return false;
+  return buffer[(x / 8) + y * ((WIDTH + 7) / 8)] & (0x80 >> (x & 7));
+}
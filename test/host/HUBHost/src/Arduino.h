@@ -0,0 +1,91 @@
+#ifndef HUB_HOST_ARDUINO_H
+#define HUB_HOST_ARDUINO_H
+
+// The parts of the Arduino AVR core the HUB libraries use, for the
+// native test build. Pin numbers follow the Mega 2560 variant.
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "HUBHost.h"
+
+#define INPUT 0
+#define OUTPUT 1
+#define LOW 0
+#define HIGH 1
+#define DEC 10
+#define HEX 16
+
+#define PIN_A0 (54)
+#define PIN_A1 (55)
+static const uint8_t A0 = PIN_A0;
+static const uint8_t A1 = PIN_A1;
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+unsigned long millis();
+unsigned long micros();
+inline void delay(unsigned long) {}
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline void analogWrite(uint8_t, int) {}
+
+inline char *ltoa(long value, char *s, int) {
+  sprintf(s, "%ld", value);
+  return s;
+}
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+class String {
+public:
+  String() {}
+  String(const char *s) : str(s ? s : "") {}
+  unsigned int length() const { return str.size(); }
+  const char *c_str() const { return str.c_str(); }
+  char operator[](unsigned int i) const { return i < str.size() ? str[i] : 0; }
+  int indexOf(char c) const {
+    size_t i = str.find(c);
+    return i == std::string::npos ? -1 : (int)i;
+  }
+  bool operator==(const String &o) const { return str == o.str; }
+  bool operator!=(const String &o) const { return str != o.str; }
+  String &operator+=(const String &o) {
+    str += o.str;
+    return *this;
+  }
+
+private:
+  std::string str;
+};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t *buf, size_t n) {
+    size_t k = 0;
+    while (n--)
+      k += write(*buf++);
+    return k;
+  }
+  size_t write(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t print(const char *s) { return write(s); }
+  size_t print(const String &s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(long v, int = DEC) {
+    char buf[12];
+    return print(ltoa(v, buf, DEC));
+  }
+  size_t print(int v, int base = DEC) { return print((long)v, base); }
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "HUBHost.h"
+#include <Arduino.h>
+
+HUBHostHook hubHostHook = nullptr;
+unsigned long hubHostMillis = 0;
+
+unsigned long millis() { return hubHostMillis; }
+unsigned long micros() { return hubHostMillis * 1000UL; }
+
+#define HUB_HOST_REG8(n) volatile HUBHostReg8 n = {0};
+#define HUB_HOST_REG16(n) volatile HUBHostReg16 n = {0};
+#define HUB_HOST_PORT(L)                                                      \
+  HUB_HOST_REG8(PORT##L) HUB_HOST_REG8(DDR##L) HUB_HOST_REG8(PIN##L)
+// UCSRnA reset value: UDREn set (data register empty)
+#define HUB_HOST_USART(N)                                                     \
+  volatile HUBHostReg8 UCSR##N##A = {1 << UDRE##N};                          \
+  HUB_HOST_REG8(UCSR##N##B) HUB_HOST_REG8(UCSR##N##C)                        \
+  HUB_HOST_REG8(UDR##N) HUB_HOST_REG16(UBRR##N)
+
+HUB_HOST_PORT(A) HUB_HOST_PORT(B) HUB_HOST_PORT(C) HUB_HOST_PORT(D)
+HUB_HOST_PORT(E) HUB_HOST_PORT(F) HUB_HOST_PORT(G) HUB_HOST_PORT(H)
+HUB_HOST_PORT(J) HUB_HOST_PORT(K) HUB_HOST_PORT(L)
+HUB_HOST_USART(1) HUB_HOST_USART(2) HUB_HOST_USART(3)
+HUB_HOST_REG8(TCCR1A) HUB_HOST_REG8(TCCR1B) HUB_HOST_REG8(TIMSK1)
+HUB_HOST_REG8(TCCR2A) HUB_HOST_REG8(TCCR2B) HUB_HOST_REG8(OCR2B)
+HUB_HOST_REG8(TCCR3A) HUB_HOST_REG8(TCCR3B) HUB_HOST_REG8(SREG)
+HUB_HOST_REG16(OCR1A) HUB_HOST_REG16(TCNT1) HUB_HOST_REG16(OCR3C)
+
+// USART side effects (UDREn/TXCn sit at the same bits in every UCSRnA):
+// a UDRn write finishes the transfer at once, writing 1 to TXCn clears it,
+// UDREn is read-only and always set
+static void usartWrite(volatile HUBHostReg8 *r, uint8_t old, uint8_t x) {
+  volatile HUBHostReg8 *const status[] = {&UCSR1A, &UCSR2A, &UCSR3A};
+  volatile HUBHostReg8 *const data[] = {&UDR1, &UDR2, &UDR3};
+  for (uint8_t i = 0; i < 3; i++) {
+    if (r == data[i])
+      status[i]->v |= (1 << UDRE1) | (1 << TXC1);
+    else if (r == status[i])
+      r->v = (old & ~(x & (1 << TXC1))) | (1 << UDRE1);
+  }
+}
+
+void HUBHostReg8::operator=(uint8_t x) volatile {
+  uint8_t old = v;
+  v = x;
+  usartWrite(this, old, x);
+  if (hubHostHook)
+    hubHostHook(this, old, x);
+}
+
+void HUBHostReg16::operator=(uint16_t x) volatile {
+  uint16_t old = v;
+  v = x;
+  if (hubHostHook)
+    hubHostHook(this, old, x);
+}
@@ -0,0 +1,28 @@
+#ifndef HUB_HOST_H
+#define HUB_HOST_H
+
+#include <stdint.h>
+
+/**
+ * @file HUBHost.h
+ * @brief Test controls for the native build of the HUB panel libraries
+ * @details The host library replaces the Arduino core, the ATmega2560 I/O
+ *          registers and Adafruit_GFX so HUBCore and HUB12Panel compile
+ *          and run on the build machine (`pio test -e native`).
+ *
+ *          Every PORTx/DDRx/USART/timer register is a plain variable.
+ *          Writes go through hubHostHook, so a test can trace the pins the
+ *          scan ISR toggles or the order a driver programs a peripheral.
+ *          The USART model completes a transfer as soon as UDRn is
+ *          written (UDREn and TXCn read back set).
+ */
+
+/// Called after every register write; `reg` is the register's address
+typedef void (*HUBHostHook)(const volatile void *reg, uint16_t oldValue,
+                            uint16_t newValue);
+extern HUBHostHook hubHostHook;
+
+/// Value returned by millis() (micros() = millis() * 1000)
+extern unsigned long hubHostMillis;
+
+#endif
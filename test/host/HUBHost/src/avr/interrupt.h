@@ -0,0 +1,11 @@
+#ifndef HUB_HOST_AVR_INTERRUPT_H
+#define HUB_HOST_AVR_INTERRUPT_H
+
+// Vectors become plain functions; a test calls the panel's scan() directly
+#define ISR(vector, ...)                                                      \
+  extern "C" void vector(void) __VA_ARGS__;                                  \
+  extern "C" void vector(void)
+#define cli() ((void)0)
+#define sei() ((void)0)
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef HUB_HOST_AVR_IO_H
+#define HUB_HOST_AVR_IO_H
+
+#include <stdint.h>
+
+// ATmega2560 registers used by HUBPins.h and HUB12Panel, as variables.
+// Writes are reported to hubHostHook (HUBHost.h).
+
+struct HUBHostReg8 {
+  uint8_t v;
+  operator uint8_t() const volatile { return v; }
+  void operator=(uint8_t x) volatile;
+  void operator|=(uint8_t x) volatile { *this = (uint8_t)(v | x); }
+  void operator&=(uint8_t x) volatile { *this = (uint8_t)(v & x); }
+  void operator^=(uint8_t x) volatile { *this = (uint8_t)(v ^ x); }
+};
+
+struct HUBHostReg16 {
+  uint16_t v;
+  operator uint16_t() const volatile { return v; }
+  void operator=(uint16_t x) volatile;
+};
+
+#define HUB_HOST_REG8(n) extern volatile HUBHostReg8 n;
+#define HUB_HOST_REG16(n) extern volatile HUBHostReg16 n;
+#define HUB_HOST_PORT(L)                                                      \
+  HUB_HOST_REG8(PORT##L) HUB_HOST_REG8(DDR##L) HUB_HOST_REG8(PIN##L)
+#define HUB_HOST_USART(N)                                                     \
+  HUB_HOST_REG8(UCSR##N##A) HUB_HOST_REG8(UCSR##N##B)                        \
+  HUB_HOST_REG8(UCSR##N##C) HUB_HOST_REG8(UDR##N) HUB_HOST_REG16(UBRR##N)
+
+HUB_HOST_PORT(A) HUB_HOST_PORT(B) HUB_HOST_PORT(C) HUB_HOST_PORT(D)
+HUB_HOST_PORT(E) HUB_HOST_PORT(F) HUB_HOST_PORT(G) HUB_HOST_PORT(H)
+HUB_HOST_PORT(J) HUB_HOST_PORT(K) HUB_HOST_PORT(L)
+HUB_HOST_USART(1) HUB_HOST_USART(2) HUB_HOST_USART(3)
+HUB_HOST_REG8(TCCR1A) HUB_HOST_REG8(TCCR1B) HUB_HOST_REG8(TIMSK1)
+HUB_HOST_REG8(TCCR2A) HUB_HOST_REG8(TCCR2B) HUB_HOST_REG8(OCR2B)
+HUB_HOST_REG8(TCCR3A) HUB_HOST_REG8(TCCR3B) HUB_HOST_REG8(SREG)
+HUB_HOST_REG16(OCR1A) HUB_HOST_REG16(TCNT1) HUB_HOST_REG16(OCR3C)
+
+#undef HUB_HOST_USART
+#undef HUB_HOST_PORT
+#undef HUB_HOST_REG16
+#undef HUB_HOST_REG8
+
+// Bit positions (same values as avr-libc iom2560.h)
+enum {
+  WGM12 = 3, CS11 = 1, CS10 = 0, OCIE1A = 1,
+  WGM30 = 0, WGM32 = 3, CS30 = 0, COM3C1 = 3,
+  UMSEL11 = 7, UMSEL10 = 6, UDORD1 = 2, UCPHA1 = 1, UCPOL1 = 0,
+  TXEN1 = 3, RXEN1 = 4, UDRE1 = 5, TXC1 = 6,
+  UMSEL21 = 7, UMSEL20 = 6, UDORD2 = 2, UCPHA2 = 1, UCPOL2 = 0,
+  TXEN2 = 3, RXEN2 = 4, UDRE2 = 5, TXC2 = 6,
+  UMSEL31 = 7, UMSEL30 = 6, UDORD3 = 2, UCPHA3 = 1, UCPOL3 = 0,
+  TXEN3 = 3, RXEN3 = 4, UDRE3 = 5, TXC3 = 6
+};
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef HUB_HOST_UTIL_ATOMIC_H
+#define HUB_HOST_UTIL_ATOMIC_H
+
+// No interrupts on the host: the block runs once
+#define ATOMIC_RESTORESTATE 0
+#define ATOMIC_FORCEON 0
+#define ATOMIC_BLOCK(type)                                                    \
+  for (uint8_t _hubAtomic = 1; _hubAtomic; _hubAtomic = 0)
+
+#endif
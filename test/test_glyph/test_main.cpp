@@ -0,0 +1,197 @@
+// HUBGlyphGFX: byte-wise glyph path against the Adafruit_GFX per-pixel path
+#include <HUBGlyph.h>
+#include <Roboto_6.h>
+#include <Roboto_Bold_12.h>
+#include <unity.h>
+
+static const int16_t CANVAS_W = 45, CANVAS_H = 20;
+static const uint16_t STRIDE = (CANVAS_W + 7) / 8;
+
+// Same 1bpp layout as the panel back buffers; drawGlyph() takes the
+// HUBGlyphGFX fast path, refWrite() the Adafruit_GFX drawChar() path
+class GlyphCanvas : public HUBGlyphGFX {
+public:
+  uint8_t buf[STRIDE * CANVAS_H];
+
+  GlyphCanvas() : HUBGlyphGFX(CANVAS_W, CANVAS_H) {
+    memset(buf, 0, sizeof(buf));
+  }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t c) override {
+    if (x < 0 || y < 0 || x >= CANVAS_W || y >= CANVAS_H)
+      return;
+    uint8_t &p = buf[y * STRIDE + x / 8];
+    if (c)
+      p |= 0x80 >> (x & 7);
+    else
+      p &= ~(0x80 >> (x & 7));
+  }
+
+  size_t refWrite(uint8_t c) { return Adafruit_GFX::write(c); }
+  void refBounds(const char *s, int16_t x, int16_t y, int16_t *x1,
+                 int16_t *y1, uint16_t *w, uint16_t *h) {
+    Adafruit_GFX::getTextBounds(s, x, y, x1, y1, w, h);
+  }
+  using HUBGlyphGFX::blitGlyph;
+
+protected:
+  void drawGlyph(const uint8_t *bits, uint8_t w, uint8_t h, int16_t x,
+                 int16_t y, uint16_t c) override {
+    blitGlyph(buf, STRIDE, CANVAS_W, CANVAS_H, bits, w, h, x, y, c != 0);
+  }
+};
+
+static const GFXfont *const fonts[] = {&Roboto_6, &Roboto_Bold_12, nullptr};
+
+static void randomText(char *s, uint8_t maxLen) {
+  uint8_t n = rand() % maxLen;
+  for (uint8_t i = 0; i < n; i++) {
+    uint8_t r = rand() % 40;
+    // Mostly printable, some newlines, CRs and characters outside the font.
+    // '~' is left out: the FontsCustom tables stop at '}' although their
+    // header says last = 0x7E.
+    s[i] = r == 0 ? '\n' : r == 1 ? '\r' : r == 2 ? (char)0x7F
+                                                  : (char)(32 + rand() % 94);
+  }
+  s[n] = 0;
+}
+
+void setUp(void) { srand(7); }
+void tearDown(void) {}
+
+void test_write_matches_adafruit(void) {
+  GlyphCanvas fast, ref;
+  char text[24];
+  for (int n = 0; n < 3000; n++) {
+    const GFXfont *font = fonts[n % 3];
+    fast.setFont(font);
+    ref.setFont(font);
+    bool wrap = rand() & 1;
+    fast.setTextWrap(wrap);
+    ref.setTextWrap(wrap);
+    uint16_t color = rand() & 1;
+    fast.setTextColor(color);
+    ref.setTextColor(color);
+    for (uint16_t i = 0; i < sizeof(fast.buf); i++)
+      fast.buf[i] = ref.buf[i] = rand();
+
+    int16_t x = rand() % 60 - 10, y = rand() % 34 - 6;
+    fast.setCursor(x, y);
+    ref.setCursor(x, y);
+    randomText(text, sizeof(text));
+    for (const char *p = text; *p; p++) {
+      fast.write((uint8_t)*p);
+      ref.refWrite((uint8_t)*p);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(ref.buf, fast.buf, sizeof(fast.buf));
+    TEST_ASSERT_EQUAL_INT16(ref.getCursorX(), fast.getCursorX());
+    TEST_ASSERT_EQUAL_INT16(ref.getCursorY(), fast.getCursorY());
+  }
+}
+
+void test_text_bounds_match_adafruit(void) {
+  GlyphCanvas c;
+  char text[24];
+  for (int n = 0; n < 3000; n++) {
+    c.setFont(fonts[n % 3]);
+    c.setTextSize(1 + rand() % 3);
+    c.setTextWrap(rand() & 1);
+    randomText(text, sizeof(text));
+    int16_t x = rand() % 40 - 5, y = rand() % 30;
+    int16_t ex1, ey1, ax1, ay1;
+    uint16_t ew, eh, aw, ah;
+    c.refBounds(text, x, y, &ex1, &ey1, &ew, &eh);
+    c.getTextBounds(text, x, y, &ax1, &ay1, &aw, &ah);
+    TEST_ASSERT_EQUAL_INT16(ex1, ax1);
+    TEST_ASSERT_EQUAL_INT16(ey1, ay1);
+    TEST_ASSERT_EQUAL_UINT16(ew, aw);
+    TEST_ASSERT_EQUAL_UINT16(eh, ah);
+  }
+}
+
+void test_span_bounds_measure_prefix(void) {
+  GlyphCanvas c;
+  c.setFont(&Roboto_Bold_12);
+  const char *text = "Hello\nWorld";
+  int16_t ex1, ey1, ax1, ay1;
+  uint16_t ew, eh, aw, ah;
+  c.refBounds("Hello", 0, 0, &ex1, &ey1, &ew, &eh);
+  c.getSpanBounds(text, 5, 0, 0, &ax1, &ay1, &aw, &ah);
+  TEST_ASSERT_EQUAL_INT16(ex1, ax1);
+  TEST_ASSERT_EQUAL_INT16(ey1, ay1);
+  TEST_ASSERT_EQUAL_UINT16(ew, aw);
+  TEST_ASSERT_EQUAL_UINT16(eh, ah);
+}
+
+void test_blit_glyph_clips_stream(void) {
+  // Glyph rows are not byte aligned in the bit stream
+  uint8_t bits[64];
+  uint8_t fast[STRIDE * CANVAS_H], ref[STRIDE * CANVAS_H];
+  for (int n = 0; n < 5000; n++) {
+    uint8_t w = 1 + rand() % 20, h = 1 + rand() % 12;
+    for (uint16_t i = 0; i < sizeof(bits); i++)
+      bits[i] = rand();
+    for (uint16_t i = 0; i < sizeof(fast); i++)
+      fast[i] = ref[i] = rand();
+    int16_t x = rand() % 80 - 25, y = rand() % 40 - 14;
+    bool on = rand() & 1;
+    GlyphCanvas::blitGlyph(fast, STRIDE, CANVAS_W, CANVAS_H, bits, w, h, x, y,
+                           on);
+    for (uint8_t row = 0; row < h; row++)
+      for (uint8_t col = 0; col < w; col++) {
+        uint16_t b = row * w + col;
+        int16_t px = x + col, py = y + row;
+        if (!(bits[b >> 3] & (0x80 >> (b & 7))) || px < 0 || py < 0 ||
+            px >= CANVAS_W || py >= CANVAS_H)
+          continue;
+        uint8_t &p = ref[py * STRIDE + px / 8];
+        if (on)
+          p |= 0x80 >> (px & 7);
+        else
+          p &= ~(0x80 >> (px & 7));
+      }
+    TEST_ASSERT_EQUAL_MEMORY(ref, fast, sizeof(fast));
+  }
+}
+
+void test_next_line_skips_empty_lines(void) {
+  const char *text = "\n\nab\n\n\ncde\nf\n";
+  uint16_t len;
+  const char *p = GlyphCanvas::nextLine(text, &len);
+  TEST_ASSERT_TRUE(p == text + 2);
+  TEST_ASSERT_EQUAL_UINT16(2, len);
+  p = GlyphCanvas::nextLine(p + len, &len);
+  TEST_ASSERT_TRUE(p == text + 7);
+  TEST_ASSERT_EQUAL_UINT16(3, len);
+  p = GlyphCanvas::nextLine(p + len, &len);
+  TEST_ASSERT_TRUE(p == text + 11);
+  TEST_ASSERT_EQUAL_UINT16(1, len);
+  TEST_ASSERT_NULL(GlyphCanvas::nextLine(p + len, &len));
+  TEST_ASSERT_NULL(GlyphCanvas::nextLine("", &len));
+}
+
+void test_line_height_follows_font(void) {
+  GlyphCanvas c;
+  int16_t x1, y1;
+  uint16_t w, h;
+  for (uint8_t i = 0; i < 3; i++) {
+    c.setFont(fonts[i]);
+    c.refBounds("Ay", 0, 0, &x1, &y1, &w, &h);
+    TEST_ASSERT_EQUAL_INT16(h, c.lineHeight());
+    c.setTextSize(2);
+    c.refBounds("Ay", 0, 0, &x1, &y1, &w, &h);
+    TEST_ASSERT_EQUAL_INT16(h, c.lineHeight());
+    c.setTextSize(1);
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_write_matches_adafruit);
+  RUN_TEST(test_text_bounds_match_adafruit);
+  RUN_TEST(test_span_bounds_measure_prefix);
+  RUN_TEST(test_blit_glyph_clips_stream);
+  RUN_TEST(test_next_line_skips_empty_lines);
+  RUN_TEST(test_line_height_follows_font);
+  return UNITY_END();
+}
@@ -0,0 +1,197 @@
+// HUB12 MSPIM backend: USART1 setup order and the shifted stream against
+// the bit-bang backend. The default env only checks that begin() refuses
+// MSPIM; native_mspim declares XCK1 wired and runs the rest.
+#include <HUB12Panel.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+typedef HUBPin<HUB12_PIN_R> PinR;
+typedef HUBPin<HUB12_PIN_CLK> PinCLK;
+typedef HUBPin<HUB12_PIN_LAT> PinLAT;
+typedef HUBPin<HUB12_PIN_A> PinA;
+typedef HUBPin<HUB12_PIN_B> PinB;
+
+static const int8_t TXD1_PIN = 18;
+
+void setUp(void) {}
+void tearDown(void) { hubHostHook = nullptr; }
+
+#if !HUB12_MSPIM_XCK_WIRED
+
+void test_mspim_needs_wired_xck(void) {
+  HUB12_Panel panel(32, 16, 2);
+  TEST_ASSERT_TRUE(panel.setScanBackend(HUB12_MSPIM));
+  // XCK1 (PD5) is not on a stock Mega header
+  TEST_ASSERT_FALSE(panel.begin(TXD1_PIN, -1, HUB12_PIN_LAT, 3, HUB12_PIN_A,
+                                HUB12_PIN_B, 32, 16, 2));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_mspim_needs_wired_xck);
+  return UNITY_END();
+}
+
+#else
+
+// ---------- Setup order ----------
+
+struct Write {
+  const volatile void *reg;
+  uint16_t value;
+};
+
+static std::vector<Write> setupLog;
+
+static void setupHook(const volatile void *reg, uint16_t, uint16_t value) {
+  if (reg == &UBRR1 || reg == &UCSR1B || reg == &UCSR1C || reg == &DDRD) {
+    Write w = {reg, value};
+    setupLog.push_back(w);
+  }
+}
+
+// ---------- Scan trace ----------
+
+// Bits per latched scan row, MSB first
+static std::vector<std::string> rows;
+static std::vector<int8_t> rowAddr;
+static std::string shifting;
+static bool clkHigh, latHigh, mspim;
+static uint16_t txcClears;
+
+static void scanHook(const volatile void *reg, uint16_t, uint16_t value) {
+  if (mspim && reg == &UCSR1A && (value & (1 << TXC1)))
+    txcClears++;
+  if (mspim && reg == &UDR1)
+    for (int8_t b = 7; b >= 0; b--)
+      shifting += (value >> b & 1) ? '1' : '0';
+
+  bool clk = PinCLK::Port::read() & PinCLK::mask;
+  bool lat = PinLAT::Port::read() & PinLAT::mask;
+  if (!mspim && clk && !clkHigh)
+    shifting += (PinR::Port::read() & PinR::mask) ? '1' : '0';
+  if (lat && !latHigh) {
+    rows.push_back(shifting);
+    rowAddr.push_back(-1);
+    shifting.clear();
+  }
+  if (!rowAddr.empty())
+    rowAddr.back() = ((PinA::Port::read() & PinA::mask) ? 1 : 0) |
+                     ((PinB::Port::read() & PinB::mask) ? 2 : 0);
+  clkHigh = clk;
+  latHigh = lat;
+}
+
+static void trace(HUB12_Panel &panel, bool usart,
+                  std::vector<std::string> &outRows,
+                  std::vector<int8_t> &outAddr) {
+  rows.clear();
+  rowAddr.clear();
+  shifting.clear();
+  txcClears = 0;
+  mspim = usart;
+  clkHigh = PinCLK::Port::read() & PinCLK::mask;
+  latHigh = PinLAT::Port::read() & PinLAT::mask;
+  hubHostHook = scanHook;
+  uint16_t ticks = 2 * 4 * panel.getColorDepth() * panel.getScanSlices();
+  for (uint16_t i = 0; i < ticks; i++)
+    panel.scan();
+  hubHostHook = nullptr;
+  outRows = rows;
+  outAddr = rowAddr;
+}
+
+static void drawFrame(HUB12_Panel &panel) {
+  srand(9);
+  for (uint16_t i = 0; i < 700; i++)
+    panel.drawPixel(rand() % panel.width(), rand() % panel.height(),
+                    rand() % (panel.getMaxLevel() + 1));
+  panel.drawLine(0, 0, panel.width() - 1, panel.height() - 1, 1);
+  panel.swapBuffers(true);
+}
+
+void test_mspim_rejects_wrong_data_pin(void) {
+  HUB12_Panel panel(32, 16, 2);
+  TEST_ASSERT_TRUE(panel.setScanBackend(HUB12_MSPIM));
+  // Data must come out on TXD1, not the bit-bang pin
+  TEST_ASSERT_FALSE(panel.begin(HUB12_PIN_R, HUB12_PIN_CLK, HUB12_PIN_LAT, 3,
+                                HUB12_PIN_A, HUB12_PIN_B, 32, 16, 2));
+}
+
+void test_mspim_setup_order_mode0_msb_first(void) {
+  HUB12_Panel panel(32, 16, 2);
+  TEST_ASSERT_TRUE(panel.setScanBackend(HUB12_MSPIM));
+  setupLog.clear();
+  hubHostHook = setupHook;
+  TEST_ASSERT_TRUE(panel.begin(TXD1_PIN, -1, HUB12_PIN_LAT, 3, HUB12_PIN_A,
+                               HUB12_PIN_B, 32, 16, 2));
+  hubHostHook = nullptr;
+
+  // ATmega2560 datasheet, USART in MSPIM mode: UBRRn = 0 while the mode
+  // is set, XCKn output before the transmitter is enabled, then the baud
+  TEST_ASSERT_EQUAL_UINT(5, setupLog.size());
+  TEST_ASSERT_TRUE(setupLog[0].reg == &UBRR1);
+  TEST_ASSERT_EQUAL_UINT16(0, setupLog[0].value);
+  TEST_ASSERT_TRUE(setupLog[1].reg == &DDRD);
+  TEST_ASSERT_EQUAL_HEX8(1 << 5, setupLog[1].value & (1 << 5)); // XCK1 = PD5
+  TEST_ASSERT_TRUE(setupLog[2].reg == &UCSR1C);
+  TEST_ASSERT_TRUE(setupLog[3].reg == &UCSR1B);
+  TEST_ASSERT_TRUE(setupLog[4].reg == &UBRR1);
+  TEST_ASSERT_EQUAL_UINT16(HUB12_MSPIM_UBRR, setupLog[4].value);
+
+  // Master SPI, mode 0 (UCPOL = 0, UCPHA = 0), MSB first (UDORD = 0)
+  uint8_t c = setupLog[2].value;
+  TEST_ASSERT_EQUAL_HEX8((1 << UMSEL11) | (1 << UMSEL10),
+                         c & ((1 << UMSEL11) | (1 << UMSEL10)));
+  TEST_ASSERT_FALSE(c & (1 << UDORD1));
+  TEST_ASSERT_FALSE(c & (1 << UCPHA1));
+  TEST_ASSERT_FALSE(c & (1 << UCPOL1));
+  // Transmitter only
+  TEST_ASSERT_EQUAL_HEX8(1 << TXEN1, setupLog[3].value);
+}
+
+void test_mspim_stream_matches_bitbang(void) {
+  for (uint8_t depth = 1; depth <= 3; depth++)
+    for (uint16_t slice = 0; slice <= 6; slice += 6) {
+      HUB12_Panel bitbang(32, 16, 2), usart(32, 16, 2);
+      TEST_ASSERT_TRUE(usart.setScanBackend(HUB12_MSPIM));
+      HUB12_Panel *both[] = {&bitbang, &usart};
+      for (uint8_t i = 0; i < 2; i++) {
+        TEST_ASSERT_TRUE(both[i]->setColorDepth(depth));
+        TEST_ASSERT_TRUE(both[i]->setScanSliceBytes(slice));
+      }
+      TEST_ASSERT_TRUE(bitbang.begin(HUB12_PIN_R, HUB12_PIN_CLK, HUB12_PIN_LAT,
+                                     3, HUB12_PIN_A, HUB12_PIN_B, 32, 16, 2));
+      TEST_ASSERT_TRUE(usart.begin(TXD1_PIN, -1, HUB12_PIN_LAT, 3,
+                                   HUB12_PIN_A, HUB12_PIN_B, 32, 16, 2));
+      drawFrame(bitbang);
+      drawFrame(usart);
+
+      std::vector<std::string> bbRows, usRows;
+      std::vector<int8_t> bbAddr, usAddr;
+      trace(bitbang, false, bbRows, bbAddr);
+      trace(usart, true, usRows, usAddr);
+      // One TXC clear per shift() call, i.e. per slice
+      TEST_ASSERT_EQUAL_UINT(usRows.size() * usart.getScanSlices(),
+                             txcClears);
+
+      TEST_ASSERT_EQUAL_UINT(2 * 4 * depth, bbRows.size());
+      TEST_ASSERT_EQUAL_UINT(bbRows.size(), usRows.size());
+      for (size_t i = 0; i < bbRows.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT(4 * 64, bbRows[i].size());
+        TEST_ASSERT_EQUAL_STRING(bbRows[i].c_str(), usRows[i].c_str());
+        TEST_ASSERT_EQUAL_INT(bbAddr[i], usAddr[i]);
+      }
+    }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_mspim_rejects_wrong_data_pin);
+  RUN_TEST(test_mspim_setup_order_mode0_msb_first);
+  RUN_TEST(test_mspim_stream_matches_bitbang);
+  return UNITY_END();
+}
+
+#endif
@@ -0,0 +1,142 @@
+// HUBRaster: span fill and bitmap blit against a per-pixel reference
+#include <HUBRaster.h>
+#include <unity.h>
+
+// 37 px wide with a 6-byte stride: the pad bits right of x = 36 and the
+// guard bytes after the buffer must never change
+static const int16_t BUF_W = 37, BUF_H = 11;
+static const uint16_t STRIDE = 6;
+static const uint16_t BUF_BYTES = STRIDE * BUF_H;
+static const uint16_t GUARD = 8;
+
+static uint8_t buf[BUF_BYTES + GUARD];
+static uint8_t ref[BUF_BYTES + GUARD];
+
+static void setPx(uint8_t *b, int16_t x, int16_t y, bool on) {
+  if (x < 0 || y < 0 || x >= BUF_W || y >= BUF_H)
+    return;
+  uint8_t &p = b[y * STRIDE + x / 8];
+  if (on)
+    p |= 0x80 >> (x & 7);
+  else
+    p &= ~(0x80 >> (x & 7));
+}
+
+static void randomFill() {
+  for (uint16_t i = 0; i < sizeof(buf); i++)
+    buf[i] = rand();
+  memcpy(ref, buf, sizeof(buf));
+}
+
+static void refFill(int16_t x, int16_t y, int16_t w, int16_t h, bool on) {
+  if (w < 0) {
+    x += w + 1;
+    w = -w;
+  }
+  if (h < 0) {
+    y += h + 1;
+    h = -h;
+  }
+  for (int16_t j = 0; j < h; j++)
+    for (int16_t i = 0; i < w; i++)
+      setPx(ref, x + i, y + j, on);
+}
+
+static void refBlit(const uint8_t *bmp, int16_t x, int16_t y, int16_t w,
+                    int16_t h, bool fg, bool bg, bool opaque) {
+  int16_t bw = (w + 7) / 8;
+  for (int16_t j = 0; j < h; j++)
+    for (int16_t i = 0; i < w; i++) {
+      bool bit = bmp[j * bw + i / 8] & (0x80 >> (i & 7));
+      if (bit)
+        setPx(ref, x + i, y + j, fg);
+      else if (opaque)
+        setPx(ref, x + i, y + j, bg);
+    }
+}
+
+void setUp(void) { srand(1); }
+void tearDown(void) {}
+
+void test_clip_normalizes_and_rejects(void) {
+  int16_t x = 10, y = 5, w = -4, h = -2;
+  TEST_ASSERT_TRUE(HUBRaster::clip(x, y, w, h, BUF_W, BUF_H));
+  TEST_ASSERT_EQUAL_INT16(7, x);
+  TEST_ASSERT_EQUAL_INT16(4, y);
+  TEST_ASSERT_EQUAL_INT16(4, w);
+  TEST_ASSERT_EQUAL_INT16(2, h);
+
+  x = -3, y = -1, w = 50, h = 20;
+  TEST_ASSERT_TRUE(HUBRaster::clip(x, y, w, h, BUF_W, BUF_H));
+  TEST_ASSERT_EQUAL_INT16(0, x);
+  TEST_ASSERT_EQUAL_INT16(0, y);
+  TEST_ASSERT_EQUAL_INT16(BUF_W, w);
+  TEST_ASSERT_EQUAL_INT16(BUF_H, h);
+
+  x = BUF_W, y = 0, w = 3, h = 3;
+  TEST_ASSERT_FALSE(HUBRaster::clip(x, y, w, h, BUF_W, BUF_H));
+  x = -3, y = 0, w = 3, h = 3;
+  TEST_ASSERT_FALSE(HUBRaster::clip(x, y, w, h, BUF_W, BUF_H));
+  x = 0, y = 0, w = 0, h = 3;
+  TEST_ASSERT_FALSE(HUBRaster::clip(x, y, w, h, BUF_W, BUF_H));
+}
+
+void test_fill_rect_matches_reference(void) {
+  for (int n = 0; n < 4000; n++) {
+    randomFill();
+    int16_t x = rand() % 60 - 12, y = rand() % 20 - 5;
+    int16_t w = rand() % 50 - 10, h = rand() % 16 - 4;
+    bool on = rand() & 1;
+    HUBRaster::fillRect(buf, STRIDE, BUF_W, BUF_H, x, y, w, h, on);
+    refFill(x, y, w, h, on);
+    TEST_ASSERT_EQUAL_MEMORY(ref, buf, sizeof(buf));
+  }
+}
+
+void test_fill_rect_single_byte_spans(void) {
+  // Every start/width inside one row, including spans within one byte
+  for (int16_t x = 0; x < BUF_W; x++)
+    for (int16_t w = 1; x + w <= BUF_W; w++) {
+      memset(buf, 0, sizeof(buf));
+      memset(ref, 0, sizeof(ref));
+      HUBRaster::fillRect(buf, STRIDE, BUF_W, BUF_H, x, 3, w, 1, true);
+      refFill(x, 3, w, 1, true);
+      TEST_ASSERT_EQUAL_MEMORY(ref, buf, sizeof(buf));
+    }
+}
+
+void test_blit_bitmap_matches_reference(void) {
+  uint8_t bmp[4 * 14];
+  for (int n = 0; n < 4000; n++) {
+    randomFill();
+    int16_t w = rand() % 30 + 1, h = rand() % 14 + 1;
+    for (uint16_t i = 0; i < sizeof(bmp); i++)
+      bmp[i] = rand();
+    int16_t x = rand() % 70 - 30, y = rand() % 30 - 14;
+    bool fg = rand() & 1, bg = rand() & 1, opaque = rand() & 1;
+    HUBRaster::blitBitmap(buf, STRIDE, BUF_W, BUF_H, bmp, false, x, y, w, h,
+                          fg, bg, opaque);
+    refBlit(bmp, x, y, w, h, fg, bg, opaque);
+    TEST_ASSERT_EQUAL_MEMORY(ref, buf, sizeof(buf));
+  }
+}
+
+void test_blit_bitmap_empty_is_noop(void) {
+  const uint8_t bmp[] = {0xFF, 0xFF};
+  randomFill();
+  HUBRaster::blitBitmap(buf, STRIDE, BUF_W, BUF_H, bmp, false, 0, 0, 0, 2,
+                        true, false, true);
+  HUBRaster::blitBitmap(buf, STRIDE, BUF_W, BUF_H, bmp, false, 0, 0, 8, -1,
+                        true, false, true);
+  TEST_ASSERT_EQUAL_MEMORY(ref, buf, sizeof(buf));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_clip_normalizes_and_rejects);
+  RUN_TEST(test_fill_rect_matches_reference);
+  RUN_TEST(test_fill_rect_single_byte_spans);
+  RUN_TEST(test_blit_bitmap_matches_reference);
+  RUN_TEST(test_blit_bitmap_empty_is_noop);
+  return UNITY_END();
+}
@@ -0,0 +1,161 @@
+// HUB12 ticker: ring buffer indexing across wrap-around, against a panel
+// that prints every item at its expected position
+#include <HUB12Panel.h>
+#include <Roboto_Bold_12.h>
+#include <unity.h>
+
+class TickerPanel : public HUB12_Panel {
+public:
+  TickerPanel() : HUB12_Panel(32, 16, 2) {}
+  using HUB12_Panel::bufferFront;
+  using HUB12_Panel::frameSize;
+  using HUB12_Panel::scrollY;
+  using HUB12_Panel::tickerCount;
+  using HUB12_Panel::tickerHead;
+
+  bool begin() {
+    return HUB12_Panel::begin(HUB12_PIN_R, HUB12_PIN_CLK, HUB12_PIN_LAT, 3,
+                              HUB12_PIN_A, HUB12_PIN_B, 32, 16, 2);
+  }
+};
+
+// Item in the reference: text and its left/right edge in scroll
+// coordinates (screen x + pixels scrolled so far)
+struct Item {
+  char text[48];
+  int32_t x, end;
+};
+
+static const uint16_t MAX_ITEMS = 512;
+static Item items[MAX_ITEMS];
+
+static void randomText(char *s, uint8_t maxLen) {
+  // Printable only ('~' is missing from the FontsCustom glyph tables)
+  uint8_t n = 1 + rand() % (maxLen - 1);
+  for (uint8_t i = 0; i < n; i++)
+    s[i] = 32 + rand() % 94;
+  s[n] = 0;
+}
+
+void setUp(void) {
+  srand(11);
+  hubHostMillis = 0;
+}
+void tearDown(void) {}
+
+static void runStream(const GFXfont *font, uint16_t gap, uint8_t depth = 1) {
+  TickerPanel ticker, ref;
+  TickerPanel *both[] = {&ticker, &ref};
+  for (uint8_t i = 0; i < 2; i++) {
+    TEST_ASSERT_TRUE(both[i]->setColorDepth(depth));
+    TEST_ASSERT_TRUE(both[i]->begin());
+    both[i]->setFont(font);
+    // Grayscale: level 2 leaves plane 0 empty and sets plane 1
+    both[i]->setTextColor(depth == 1 ? 1 : 2);
+    both[i]->setTextWrap(false);
+  }
+  ticker.setScrollLoop(true, gap);
+  TEST_ASSERT_TRUE(ticker.startTicker());
+  ticker.setScrollRate(100 << 8); // 4 px per 40 ms step
+
+  const int32_t width = ticker.width();
+  uint16_t count = 0, first = 0, wraps = 0;
+  int32_t scrolled = 0, tail = width;
+  for (uint16_t step = 0; step < 3000; step++) {
+    if (rand() % 8 == 0 && count < MAX_ITEMS) {
+      Item &it = items[count];
+      randomText(it.text, sizeof(it.text));
+      bool wasEmpty = ticker.tickerCount == 0;
+      uint16_t freeBefore = ticker.getTickerFree();
+      if (ticker.appendTicker(it.text)) {
+        // Enters at the right edge, `gap` px after the previous item
+        it.x = wasEmpty ? width + scrolled : tail + gap;
+        if (it.x < width + scrolled)
+          it.x = width + scrolled;
+        ref.setCursor(0, 0);
+        ref.print(it.text);
+        it.end = it.x + ref.getCursorX();
+        tail = it.end;
+        count++;
+      } else {
+        // Rejected items leave the ring untouched
+        TEST_ASSERT_EQUAL_UINT16(freeBefore, ticker.getTickerFree());
+      }
+    }
+
+    uint16_t head = ticker.tickerHead;
+    hubHostMillis += 40;
+    ticker.updateScrolling();
+    scrolled += 4;
+    if (ticker.tickerHead < head)
+      wraps++;
+    TEST_ASSERT_TRUE(ticker.tickerHead < HUB12_TICKER_RING);
+    TEST_ASSERT_TRUE(ticker.tickerCount <= HUB12_TICKER_RING);
+    TEST_ASSERT_EQUAL_UINT16(HUB12_TICKER_RING - ticker.tickerCount,
+                             ticker.getTickerFree());
+
+    ref.beginFrame();
+    ref.clearScreen();
+    // Items fully past the left edge (+ glyph overhang) are not drawn
+    while (first < count && items[first].end + 8 < scrolled)
+      first++;
+    for (uint16_t i = first; i < count; i++) {
+      ref.setCursor(items[i].x - scrolled, ticker.scrollY);
+      ref.print(items[i].text);
+    }
+    ref.commitFrame(true);
+    TEST_ASSERT_EQUAL_MEMORY(ref.bufferFront, ticker.bufferFront,
+                             ticker.frameSize);
+  }
+  // The head went past the end of the ring and back to index 0
+  TEST_ASSERT_GREATER_THAN(0, wraps);
+  ticker.stopScrolling();
+  TEST_ASSERT_FALSE(ticker.isTickerActive());
+}
+
+void test_ticker_stream_builtin_font(void) {
+  runStream(nullptr, 0);
+  runStream(nullptr, 21);
+}
+
+void test_ticker_stream_gfx_font(void) {
+  runStream(&Roboto_Bold_12, 7);
+  runStream(&Roboto_Bold_12, 300); // Gap needs two pad markers
+}
+
+void test_ticker_stream_grayscale(void) {
+  // Shifted window and entering glyphs on every BCM plane
+  runStream(&Roboto_Bold_12, 7, 2);
+  runStream(nullptr, 21, 3);
+}
+
+void test_ticker_rejects_whole_item_when_full(void) {
+  TickerPanel ticker;
+  TEST_ASSERT_TRUE(ticker.begin());
+  TEST_ASSERT_FALSE(ticker.appendTicker("off")); // Not started
+  TEST_ASSERT_TRUE(ticker.startTicker());
+  TEST_ASSERT_FALSE(ticker.appendTicker(""));
+
+  char big[200];
+  memset(big, 'A', sizeof(big) - 1);
+  big[sizeof(big) - 1] = 0;
+  uint8_t n = 0;
+  while (ticker.appendTicker(big))
+    n++;
+  TEST_ASSERT_EQUAL_UINT8(HUB12_TICKER_RING / (sizeof(big) + 1), n);
+  uint16_t used = ticker.tickerCount;
+  TEST_ASSERT_FALSE(ticker.appendTicker(big));
+  TEST_ASSERT_EQUAL_UINT16(used, ticker.tickerCount);
+  TEST_ASSERT_TRUE(ticker.appendTicker("x")); // Still room for a short one
+  ticker.stopScrolling();
+  TEST_ASSERT_EQUAL_UINT16(0, ticker.getTickerFree());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_ticker_stream_builtin_font);
+  RUN_TEST(test_ticker_stream_gfx_font);
+  RUN_TEST(test_ticker_stream_grayscale);
+  RUN_TEST(test_ticker_rejects_whole_item_when_full);
+  return UNITY_END();
+}
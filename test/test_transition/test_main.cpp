@@ -0,0 +1,147 @@
+// HUB12 DISSOLVE transition: Galois LFSR pixel order and coverage
+#include <HUB12Panel.h>
+#include <unity.h>
+
+// Front/back buffers and transition state of the panel under test
+class TransPanel : public HUB12_Panel {
+public:
+  TransPanel(uint16_t w, uint16_t h, uint16_t chain)
+      : HUB12_Panel(w, h, chain) {}
+  using HUB12_Panel::bufferBack;
+  using HUB12_Panel::bufferFront;
+  using HUB12_Panel::bufferSize;
+  using HUB12_Panel::frameSize;
+  using HUB12_Panel::transPos;
+  using HUB12_Panel::transTotal;
+
+  bool lit(const uint8_t *buf, uint8_t plane, uint16_t i) const {
+    return buf[plane * bufferSize + i / 8] & (0x80 >> (i & 7));
+  }
+};
+
+// Maximal-length Galois taps for an n-bit register, n = 2..16
+static const uint16_t lfsrTaps[] = {0x0003, 0x0006, 0x000C, 0x0014, 0x0030,
+                                    0x0060, 0x00B8, 0x0110, 0x0240, 0x0500,
+                                    0x0829, 0x100D, 0x2015, 0x6000, 0xD008};
+
+// Pixel order of a dissolve over `total` pixels: state - 1 of the
+// smallest register with 2^n - 1 >= total, states past the panel skipped
+static void dissolveOrder(uint16_t *order, uint16_t total) {
+  uint8_t n = 2;
+  while (n < 16 && ((1UL << n) - 1) < total)
+    n++;
+  uint16_t lfsr = 1, k = 0;
+  do {
+    uint16_t idx = lfsr - 1;
+    lfsr = (lfsr >> 1) ^ ((lfsr & 1) ? lfsrTaps[n - 2] : 0);
+    if (idx < total)
+      order[k++] = idx;
+  } while (lfsr != 1);
+  TEST_ASSERT_EQUAL_UINT16(total, k);
+}
+
+static const uint16_t sizes[][2] = {{4, 1}, {8, 1}, {16, 1},
+                                    {16, 2}, {16, 3}, {16, 4}};
+
+static TransPanel *beginPanel(uint16_t h, uint16_t chain, uint8_t depth) {
+  TransPanel *p = new TransPanel(32, h, chain);
+  TEST_ASSERT_TRUE(p->setColorDepth(depth));
+  TEST_ASSERT_TRUE(p->begin(HUB12_PIN_R, HUB12_PIN_CLK, HUB12_PIN_LAT, 3,
+                            HUB12_PIN_A, HUB12_PIN_B, 32, h, chain));
+  return p;
+}
+
+void setUp(void) {
+  srand(5);
+  hubHostMillis = 1000;
+}
+void tearDown(void) {}
+
+void test_dissolve_lights_each_pixel_once(void) {
+  for (uint8_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    for (uint8_t depth = 1; depth <= 2; depth++) {
+      TransPanel *p = beginPanel(sizes[s][0], sizes[s][1], depth);
+      uint16_t total = p->width() * p->height();
+      uint8_t *seen = new uint8_t[total]();
+
+      p->beginFrame();
+      p->fillScreen(p->getMaxLevel());
+      TEST_ASSERT_TRUE(p->commitTransition(HUB12_TRANSITION_DISSOLVE, 900));
+      TEST_ASSERT_EQUAL_UINT16(total, p->transTotal);
+
+      uint16_t steps = 0;
+      while (p->isTransitionActive()) {
+        hubHostMillis += 1 + rand() % 20;
+        p->updateTransition();
+        steps++;
+        uint16_t on = 0;
+        for (uint16_t i = 0; i < total; i++) {
+          bool v = p->lit(p->bufferFront, 0, i);
+          for (uint8_t plane = 1; plane < depth; plane++)
+            TEST_ASSERT_EQUAL(v, p->lit(p->bufferFront, plane, i));
+          // Once moved, a pixel stays on the new frame
+          TEST_ASSERT_TRUE(v || !seen[i]);
+          seen[i] |= v;
+          on += v;
+        }
+        TEST_ASSERT_EQUAL_UINT16(p->isTransitionActive() ? p->transPos : total,
+                                 on);
+      }
+      TEST_ASSERT_GREATER_THAN(10, steps);
+      TEST_ASSERT_EQUAL_MEMORY(p->bufferBack, p->bufferFront, p->frameSize);
+      delete[] seen;
+      delete p;
+    }
+}
+
+void test_dissolve_follows_lfsr_order(void) {
+  for (uint8_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    TransPanel *p = beginPanel(sizes[s][0], sizes[s][1], 2);
+    uint16_t total = p->width() * p->height();
+    uint16_t *order = new uint16_t[total];
+    dissolveOrder(order, total);
+
+    // Old frame A on screen, new frame B in the back buffer
+    p->beginFrame();
+    for (uint16_t i = 0; i < 300; i++)
+      p->drawPixel(rand() % p->width(), rand() % p->height(), rand() % 4);
+    p->commitFrame();
+    uint8_t *a = new uint8_t[p->frameSize];
+    memcpy(a, p->bufferFront, p->frameSize);
+    p->beginFrame();
+    for (uint16_t i = 0; i < 300; i++)
+      p->drawPixel(rand() % p->width(), rand() % p->height(), rand() % 4);
+    TEST_ASSERT_TRUE(p->commitTransition(HUB12_TRANSITION_DISSOLVE, 700));
+
+    // Expected front: A, with the first transPos pixels of the order from B
+    uint8_t *expect = new uint8_t[p->frameSize];
+    uint16_t done = 0;
+    memcpy(expect, a, p->frameSize);
+    while (p->isTransitionActive()) {
+      hubHostMillis += 1 + rand() % 30;
+      p->updateTransition();
+      uint16_t to = p->isTransitionActive() ? p->transPos : total;
+      for (; done < to; done++) {
+        uint16_t i = order[done];
+        for (uint8_t plane = 0; plane < 2; plane++) {
+          uint8_t m = 0x80 >> (i & 7);
+          uint8_t &e = expect[plane * p->bufferSize + i / 8];
+          e = p->lit(p->bufferBack, plane, i) ? (e | m) : (e & ~m);
+        }
+      }
+      TEST_ASSERT_EQUAL_MEMORY(expect, p->bufferFront, p->frameSize);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(p->bufferBack, p->bufferFront, p->frameSize);
+    delete[] expect;
+    delete[] a;
+    delete[] order;
+    delete p;
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_dissolve_lights_each_pixel_once);
+  RUN_TEST(test_dissolve_follows_lfsr_order);
+  return UNITY_END();
+}
@@ -0,0 +1,184 @@
+// HUB12 wire buffer: bits shifted by the scan ISR against a shadow frame.
+// Covers buildWireBuffer() (row interleave, byte order, inversion, BCM
+// planes), partial rebuilds of dirty rows and the unrolled HUB12_FixedPanel
+// scan; in the native_lines2 env also packLines() for parallel data.
+#include <HUB12Panel.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+typedef HUBPin<HUB12_PIN_R> PinR;
+typedef HUBPin<HUB12_PIN_CLK> PinCLK;
+typedef HUBPin<HUB12_PIN_LAT> PinLAT;
+typedef HUBPin<HUB12_PIN_A> PinA;
+typedef HUBPin<HUB12_PIN_B> PinB;
+
+static const uint8_t LINES = HUB12_DATA_LINES;
+static const uint16_t PANEL_W = 32, PANEL_H = 16, CHAIN = 4;
+static const uint16_t WIDTH = PANEL_W * CHAIN;
+
+// One latched scan row: the bits clocked into each data line, MSB first
+struct Latch {
+  std::string bits[LINES];
+  int8_t addr;
+};
+
+static std::vector<Latch> latches;
+static std::string shifting[LINES];
+static bool clkHigh, latHigh;
+
+static void traceHook(const volatile void *, uint16_t, uint16_t) {
+  bool clk = PinCLK::Port::read() & PinCLK::mask;
+  bool lat = PinLAT::Port::read() & PinLAT::mask;
+  if (clk && !clkHigh)
+    for (uint8_t k = 0; k < LINES; k++)
+      shifting[k] += (PinR::Port::read() >> (PinR::bit + k) & 1) ? '1' : '0';
+  if (lat && !latHigh) {
+    Latch l;
+    for (uint8_t k = 0; k < LINES; k++) {
+      l.bits[k] = shifting[k];
+      shifting[k].clear();
+    }
+    l.addr = -1;
+    latches.push_back(l);
+  }
+  // Row address is set after the latch, before the next row is shifted
+  if (!latches.empty())
+    latches.back().addr = ((PinA::Port::read() & PinA::mask) ? 1 : 0) |
+                          ((PinB::Port::read() & PinB::mask) ? 2 : 0);
+  clkHigh = clk;
+  latHigh = lat;
+}
+
+// Shadow frame: the level drawn at each pixel
+static uint8_t shadow[PANEL_H][WIDTH];
+
+template <class P>
+static void plot(P &panel, int16_t x, int16_t y, uint8_t c) {
+  panel.drawPixel(x, y, c);
+  shadow[y][x] = c;
+}
+
+template <class P> static void randomFrame(P &panel, uint16_t pixels) {
+  uint8_t levels = panel.getMaxLevel() + 1;
+  for (uint16_t i = 0; i < pixels; i++)
+    plot(panel, rand() % WIDTH, rand() % PANEL_H, rand() % levels);
+}
+
+// Expected stream for scan row `row`, plane `plane`, data line `k`: the
+// line's sub-chain, byte by byte, rows row+12, +8, +4, +0, inverted
+static std::string expectedBits(uint8_t row, uint8_t plane, uint8_t k) {
+  uint16_t seg = WIDTH / 8 / LINES;
+  std::string e;
+  for (uint16_t j = 0; j < seg; j++)
+    for (int8_t q = 3; q >= 0; q--)
+      for (uint8_t bit = 0; bit < 8; bit++) {
+        uint8_t level = shadow[row + q * 4][(k * seg + j) * 8 + bit];
+        e += (level >> plane & 1) ? '0' : '1';
+      }
+  return e;
+}
+
+// Two scan frames through scan() (P::scan is the fixed-geometry one for
+// HUB12_FixedPanel), then check every latch against the shadow
+template <class P> static void checkScan(P &panel) {
+  uint8_t planes = panel.getColorDepth();
+  uint16_t ticks = 2 * 4 * planes * panel.getScanSlices();
+  latches.clear();
+  for (uint8_t k = 0; k < LINES; k++)
+    shifting[k].clear();
+  clkHigh = PinCLK::Port::read() & PinCLK::mask;
+  latHigh = PinLAT::Port::read() & PinLAT::mask;
+  hubHostHook = traceHook;
+  for (uint16_t i = 0; i < ticks; i++)
+    panel.scan();
+  hubHostHook = nullptr;
+
+  TEST_ASSERT_EQUAL_UINT(2 * 4 * planes, latches.size());
+  uint8_t row = 0, plane = 0;
+  for (size_t i = 0; i < latches.size(); i++) {
+    for (uint8_t k = 0; k < LINES; k++)
+      TEST_ASSERT_EQUAL_STRING(expectedBits(row, plane, k).c_str(),
+                               latches[i].bits[k].c_str());
+    TEST_ASSERT_EQUAL_INT(row, latches[i].addr);
+    if (++plane == planes) {
+      plane = 0;
+      row = (row + 1) & 3;
+    }
+  }
+}
+
+void setUp(void) { srand(3); }
+void tearDown(void) { hubHostHook = nullptr; }
+
+template <class P>
+static void runScenario(P &panel, uint8_t depth, uint16_t sliceBytes,
+                        bool triple) {
+  memset(shadow, 0, sizeof(shadow));
+  TEST_ASSERT_TRUE(panel.setColorDepth(depth));
+  TEST_ASSERT_TRUE(panel.setScanSliceBytes(sliceBytes));
+  TEST_ASSERT_TRUE(panel.setTripleBuffering(triple));
+  TEST_ASSERT_TRUE(panel.begin(HUB12_PIN_R, HUB12_PIN_CLK, HUB12_PIN_LAT, 3,
+                               HUB12_PIN_A, HUB12_PIN_B, PANEL_W, PANEL_H,
+                               CHAIN));
+  checkScan(panel);
+
+  // Full frame
+  randomFrame(panel, 900);
+  panel.swapBuffers(true);
+  checkScan(panel);
+
+  // Partial update: only the touched rows are rebuilt
+  for (uint8_t n = 0; n < 3; n++) {
+    int16_t y = rand() % PANEL_H;
+    for (int16_t x = 0; x < WIDTH; x += 3)
+      plot(panel, x, y, rand() % (panel.getMaxLevel() + 1));
+    panel.swapBuffers(true);
+    checkScan(panel);
+  }
+}
+
+void test_runtime_panel_wire_order(void) {
+  for (uint8_t depth = 1; depth <= 3; depth++)
+    for (uint8_t triple = 0; triple < 2; triple++) {
+      HUB12_Panel panel(PANEL_W, PANEL_H, CHAIN);
+      runScenario(panel, depth, 0, triple);
+    }
+}
+
+void test_runtime_panel_time_sliced(void) {
+  for (uint8_t depth = 1; depth <= 3; depth++) {
+    HUB12_Panel panel(PANEL_W, PANEL_H, CHAIN);
+    runScenario(panel, depth, 5, false);
+  }
+}
+
+// Wraps HUB12_FixedPanel::begin() so runScenario() can call both kinds
+class FixedPanel : public HUB12_FixedPanel<PANEL_W, PANEL_H, CHAIN> {
+public:
+  bool begin(int8_t r, int8_t clk, int8_t lat, int8_t oe, int8_t a, int8_t b,
+             uint16_t, uint16_t, uint16_t) {
+    return HUB12_FixedPanel<PANEL_W, PANEL_H, CHAIN>::begin(r, clk, lat, oe,
+                                                            a, b);
+  }
+};
+
+// begin() does not link without the vector; the tests call scan() directly
+static FixedPanel isrPanel;
+HUB12_FIXED_ISR(isrPanel)
+
+void test_fixed_panel_wire_order(void) {
+  for (uint8_t depth = 1; depth <= 3; depth++)
+    for (uint16_t slice = 0; slice <= 7; slice += 7) {
+      FixedPanel panel;
+      runScenario(panel, depth, slice, false);
+    }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_runtime_panel_wire_order);
+  RUN_TEST(test_runtime_panel_time_sliced);
+  RUN_TEST(test_fixed_panel_wire_order);
+  return UNITY_END();
+}